@@ -396,13 +396,15 @@ namespace netxs::app::shared
             });
             return window_ptr;
         };
-        auto build_dtvt = [](eccc appcfg, settings& /*config*/)
+        auto build_dtvt = [](eccc appcfg, settings& config)
         {
             return ui::dtvt::ctor()
                 ->plugin<pro::focus>(pro::focus::mode::relay)
                 ->limits(dot_11)
                 ->invoke([&](auto& boss)
                 {
+                    boss.packed = config.settings::take("/config/directvt/compression", faux);
+                    boss.poller = config.settings::take("/config/directvt/reactor", faux);
                     boss.LISTEN(tier::anycast, e2::form::upon::started, root_ptr, -, (appcfg))
                     {
                         if (root_ptr) // root_ptr is empty when d_n_d.
@@ -424,7 +426,7 @@ namespace netxs::app::shared
                     };
                 });
         };
-        auto build_dtty = [](eccc appcfg, settings& /*config*/)
+        auto build_dtty = [](eccc appcfg, settings& config)
         {
             auto window_clr = skin::color(tone::window_clr);
             auto window_ptr = ui::veer::ctor(true /* Notify everyone on resize. */)
@@ -437,6 +439,8 @@ namespace netxs::app::shared
             auto dtvt = ui::dtvt::ctor()
                 ->plugin<pro::focus>(pro::focus::mode::relay, faux/*no default focus*/)
                 ->limits(dot_11);
+            dtvt->packed = config.settings::take("/config/directvt/compression", faux);
+            dtvt->poller = config.settings::take("/config/directvt/reactor", faux);
             auto scrl = term_cake->attach(ui::rail::ctor());
             auto term = scrl->attach(ui::term::ctor())
                 ->plugin<pro::focus>(pro::focus::mode::focused)
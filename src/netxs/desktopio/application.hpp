@@ -986,7 +986,8 @@ namespace netxs::app::shared
                                       .blink_rate   = config.settings::take("/config/gui/blinkrate", span{ 400ms }),
                                       .wincoord     = config.settings::take("/config/gui/wincoor", dot_mx),
                                       .gridsize     = config.settings::take("/config/gui/gridsize", dot_mx),
-                                      .cell_height  = std::clamp(config.settings::take("/config/gui/cellheight", si32{ 20 }), 0, 256) };
+                                      .cell_height  = std::clamp(config.settings::take("/config/gui/cellheight", si32{ 20 }), 0, 256),
+                                      .glyph_cache  = std::clamp(config.settings::take("/config/gui/glyphcache", si32{ 64 }), 1, 4096) };
         if (gui_config.cell_height == 0) gui_config.cell_height = 20;
         if (gui_config.gridsize.x == 0 || gui_config.gridsize.y == 0) gui_config.gridsize = dot_mx;
         auto fonts_context = config.settings::push_context("/config/gui/fonts/");
@@ -1057,6 +1058,7 @@ namespace netxs::app::shared
         g.maxfps            = config.settings::take("/config/timings/fps"                    , 60);
         g.max_value         = config.settings::take("/config/desktop/windowmax"              , twod{ 3000, 2000  });
         g.macstyle          = config.settings::take("/config/desktop/macstyle"               , faux);
+        g.compositor        = config.settings::take("/config/desktop/compositor"             , faux);
         g.menuwide          = config.settings::take("/config/desktop/taskbar/wide"           , faux);
         if (g.maxfps <= 0) g.maxfps = 60;
 
@@ -660,6 +660,7 @@ namespace netxs::ui
         bool tracking = faux;
         bool menuwide = faux;
         bool macstyle = faux;
+        bool compositor = faux;
 
         si32 spd;
         si32 pls;
@@ -480,6 +480,105 @@ namespace netxs
         {
             mix(c);
         }
+        // argb: Alpha blend the color over the span of colors (batched argb::mix).
+        static void blend(argb* head, argb* tail, argb c)
+        {
+            if (c.chan.a == 0xFF) std::fill(head, tail, c);
+            else if (c.chan.a)
+            {
+                #if defined(VTM_SIMD_DISPATCH)
+                if (netxs::cpu_avx2()) head = blend_avx2(head, tail, c);
+                #endif
+                while (head != tail) (head++)->mix(c);
+            }
+        }
+        // argb: Sum alpha channels of the span of colors and k = 0..255 (batched argb::alpha_sum).
+        static void alpha_sum(argb* head, argb* tail, si32 k)
+        {
+            if (k < 0 || k > 255)
+            {
+                while (head != tail) (head++)->alpha_sum(k);
+                return;
+            }
+            #if defined(VTM_SIMD_DISPATCH)
+            if (netxs::cpu_avx2()) head = adds_avx2(head, tail, (ui32)k << 24);
+            #endif
+            #if defined(VTM_SIMD_SSE2)
+            auto kv = _mm_set1_epi32((int)((ui32)k << 24));
+            while (tail - head >= 4)
+            {
+                auto v = _mm_loadu_si128((__m128i const*)head);
+                _mm_storeu_si128((__m128i*)head, _mm_adds_epu8(v, kv));
+                head += 4;
+            }
+            #endif
+            while (head != tail) (head++)->alpha_sum(k);
+        }
+        // argb: Sum the span of alpha values and src = 0..255 (batched argb::alpha_mix).
+        static void alpha_mix(byte* head, byte* tail, si32 src)
+        {
+            if (src < 0 || src > 255)
+            {
+                while (head != tail) alpha_mix(src, *head++);
+                return;
+            }
+            #if defined(VTM_SIMD_SSE2)
+            auto kv = _mm_set1_epi8((char)src);
+            while (tail - head >= 16)
+            {
+                auto v = _mm_loadu_si128((__m128i const*)head);
+                _mm_storeu_si128((__m128i*)head, _mm_adds_epu8(v, kv));
+                head += 16;
+            }
+            #endif
+            while (head != tail) alpha_mix(src, *head++);
+        }
+        #if defined(VTM_SIMD_DISPATCH)
+        // argb: AVX2 argb::mix for eight colors at a time. Return the rest of the span.
+        VTM_TARGET_AVX2 static argb* blend_avx2(argb* head, argb* tail, argb c)
+        {
+            auto a2 = _mm256_set1_epi32(c.chan.a);
+            auto ff = _mm256_set1_epi32(0xFF);
+            auto kr = _mm256_set1_epi32(c.chan.r * c.chan.a);
+            auto kg = _mm256_set1_epi32(c.chan.g * c.chan.a);
+            auto kb = _mm256_set1_epi32(c.chan.b * c.chan.a);
+            while (tail - head >= 8)
+            {
+                auto v = _mm256_loadu_si256((__m256i const*)head);
+                auto a1 = _mm256_srli_epi32(v, 24);
+                auto a = _mm256_sub_epi32(_mm256_slli_epi32(_mm256_add_epi32(a1, a2), 8), _mm256_mullo_epi32(a1, a2)); // ((a2 + a1) << 8) - a1 * a2
+                auto fa = _mm256_cvtepi32_ps(a);
+                auto r = _mm256_srli_epi32(a, 8);
+                for (auto shift : { 16, 8, 0 }) // d = ((c2 * a2 + c1 * a1) << 8) - c1 * a1 * a2, c = d / a.
+                {
+                    auto k = shift == 16 ? kr : shift == 8 ? kg : kb;
+                    auto c1 = _mm256_and_si256(_mm256_srli_epi32(v, shift), ff);
+                    auto t = _mm256_mullo_epi32(c1, a1);
+                    auto d = _mm256_sub_epi32(_mm256_slli_epi32(_mm256_add_epi32(k, t), 8), _mm256_mullo_epi32(t, a2));
+                    auto q = _mm256_cvttps_epi32(_mm256_div_ps(_mm256_cvtepi32_ps(d), fa));
+                    auto e = _mm256_sub_epi32(d, _mm256_mullo_epi32(q, a)); // Fix the rounding error of the float division.
+                    q = _mm256_add_epi32(q, _mm256_cmpgt_epi32(_mm256_setzero_si256(), e));
+                    q = _mm256_sub_epi32(q, _mm256_andnot_si256(_mm256_cmpgt_epi32(a, e), _mm256_set1_epi32(-1)));
+                    r = _mm256_or_si256(_mm256_slli_epi32(r, 8), _mm256_and_si256(q, ff));
+                }
+                _mm256_storeu_si256((__m256i*)head, r);
+                head += 8;
+            }
+            return head;
+        }
+        // argb: AVX2 saturated byte addition of k to eight colors at a time. Return the rest of the span.
+        VTM_TARGET_AVX2 static argb* adds_avx2(argb* head, argb* tail, ui32 k)
+        {
+            auto kv = _mm256_set1_epi32((int)k);
+            while (tail - head >= 8)
+            {
+                auto v = _mm256_loadu_si256((__m256i const*)head);
+                _mm256_storeu_si256((__m256i*)head, _mm256_adds_epu8(v, kv));
+                head += 8;
+            }
+            return head;
+        }
+        #endif
         // argb: ARGB transitional blending. Level = 0: equals c1, level = 256: equals c2.
         static auto transit(argb c1, argb c2, si32 level)
         {
@@ -1229,6 +1328,101 @@ namespace netxs
                          to_srgb_byte(pma_lin.b),
                          (byte)(pma_lin.a * 255.f + 0.5f) };
         }
+        // irgb: Add the span of colors and subtract the other one from the span of accumulators (batched operator += and operator -=).
+        static void slide(irgb* head, irgb* tail, irgb const* add, irgb const* sub) requires(std::is_same_v<T, si32>)
+        {
+            #if defined(VTM_SIMD_DISPATCH)
+            if (netxs::cpu_avx2()) head = slide_avx2(head, tail, add, sub);
+            #endif
+            #if defined(VTM_SIMD_SSE2)
+            while (head != tail)
+            {
+                auto v = _mm_loadu_si128((__m128i const*)head);
+                v = _mm_add_epi32(v, _mm_loadu_si128((__m128i const*)add++));
+                _mm_storeu_si128((__m128i*)head++, _mm_sub_epi32(v, _mm_loadu_si128((__m128i const*)sub++)));
+            }
+            #endif
+            while (head != tail)
+            {
+                *head += *add++;
+                *head++ -= *sub++;
+            }
+        }
+        // irgb: Divide the span of non-negative accumulators by n (n * 256 <= 2^24) and convert to argb (batched operator / and operator argb).
+        static void average(irgb const* head, irgb const* tail, si32 n, argb* dest) requires(std::is_same_v<T, si32>)
+        {
+            #if defined(VTM_SIMD_DISPATCH)
+            if (netxs::cpu_avx2()) head = average_avx2(head, tail, n, dest);
+            #endif
+            #if defined(VTM_SIMD_SSE2)
+            auto nf = _mm_set1_ps((fp32)n);
+            auto kf = _mm_set1_ps(1.f / n);
+            auto ff = _mm_set1_epi32(0xFF);
+            auto quotient = [&](irgb const* src) // Truncated division in floats: the values are exact below 2^24, the reciprocal error is fixed by the remainder sign.
+            {
+                auto af = _mm_cvtepi32_ps(_mm_loadu_si128((__m128i const*)src));
+                auto qf = _mm_cvtepi32_ps(_mm_cvttps_epi32(_mm_mul_ps(af, kf)));
+                auto ef = _mm_sub_ps(af, _mm_mul_ps(qf, nf));
+                qf = _mm_sub_ps(qf, _mm_and_ps(_mm_cmplt_ps(ef, _mm_setzero_ps()), _mm_set1_ps(1.f)));
+                qf = _mm_add_ps(qf, _mm_and_ps(_mm_cmpge_ps(ef, nf), _mm_set1_ps(1.f)));
+                auto q = _mm_and_si128(_mm_cvttps_epi32(qf), ff); // static_cast<byte>.
+                return _mm_shuffle_epi32(q, _MM_SHUFFLE(3, 0, 1, 2)); // r, g, b, a -> b, g, r, a.
+            };
+            while (tail - head >= 4)
+            {
+                auto lo = _mm_packs_epi32(quotient(head + 0), quotient(head + 1));
+                auto hi = _mm_packs_epi32(quotient(head + 2), quotient(head + 3));
+                _mm_storeu_si128((__m128i*)dest, _mm_packus_epi16(lo, hi));
+                head += 4;
+                dest += 4;
+            }
+            #endif
+            while (head != tail) *dest++ = *head++ / n;
+        }
+        #if defined(VTM_SIMD_DISPATCH)
+        // irgb: AVX2 irgb::slide for two accumulators at a time. Return the rest of the span.
+        VTM_TARGET_AVX2 static irgb* slide_avx2(irgb* head, irgb* tail, irgb const*& add, irgb const*& sub)
+        {
+            while (tail - head >= 2)
+            {
+                auto v = _mm256_loadu_si256((__m256i const*)head);
+                v = _mm256_add_epi32(v, _mm256_loadu_si256((__m256i const*)add));
+                _mm256_storeu_si256((__m256i*)head, _mm256_sub_epi32(v, _mm256_loadu_si256((__m256i const*)sub)));
+                head += 2;
+                add += 2;
+                sub += 2;
+            }
+            return head;
+        }
+        // irgb: AVX2 irgb::average quotient of two accumulators (see irgb::average).
+        VTM_TARGET_AVX2 static __m256i quotient_avx2(irgb const* src, __m256 nf, __m256 kf)
+        {
+            auto af = _mm256_cvtepi32_ps(_mm256_loadu_si256((__m256i const*)src));
+            auto qf = _mm256_cvtepi32_ps(_mm256_cvttps_epi32(_mm256_mul_ps(af, kf)));
+            auto ef = _mm256_sub_ps(af, _mm256_mul_ps(qf, nf));
+            qf = _mm256_sub_ps(qf, _mm256_and_ps(_mm256_cmp_ps(ef, _mm256_setzero_ps(), _CMP_LT_OQ), _mm256_set1_ps(1.f)));
+            qf = _mm256_add_ps(qf, _mm256_and_ps(_mm256_cmp_ps(ef, nf, _CMP_GE_OQ), _mm256_set1_ps(1.f)));
+            auto q = _mm256_and_si256(_mm256_cvttps_epi32(qf), _mm256_set1_epi32(0xFF));
+            return _mm256_shuffle_epi32(q, _MM_SHUFFLE(3, 0, 1, 2)); // Two colors: r, g, b, a -> b, g, r, a.
+        }
+        // irgb: AVX2 irgb::average for eight accumulators at a time. Return the rest of the span.
+        VTM_TARGET_AVX2 static irgb const* average_avx2(irgb const* head, irgb const* tail, si32 n, argb*& dest)
+        {
+            auto nf = _mm256_set1_ps((fp32)n);
+            auto kf = _mm256_set1_ps(1.f / n);
+            while (tail - head >= 8)
+            {
+                auto lo = _mm256_packs_epi32(quotient_avx2(head + 0, nf, kf), quotient_avx2(head + 2, nf, kf)); // Packing is done within 128-bit lanes: 0 2 | 1 3.
+                auto hi = _mm256_packs_epi32(quotient_avx2(head + 4, nf, kf), quotient_avx2(head + 6, nf, kf)); //                                     4 6 | 5 7.
+                auto v = _mm256_packus_epi16(lo, hi);                                                           //                             0 2 4 6 | 1 3 5 7.
+                v = _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7));
+                _mm256_storeu_si256((__m256i*)dest, v);
+                head += 8;
+                dest += 8;
+            }
+            return head;
+        }
+        #endif
         // irgb: non-PMA sRGB (8-bit) -> PMA Linear (irgb).
         static auto nonpma_srgb_to_pma_linear(argb nonpma_pixel) requires(std::is_floating_point_v<T>)
         {
@@ -1834,6 +2028,9 @@ namespace netxs
         }
         struct glyf
         {
+            // glyf: Store of the clusters that do not fit in the token. Entries are not reclaimed: the store grows with the number of distinct jumbo clusters.
+            //todo Reclamation needs a mark pass over every token holder. Tokens are copied as plain values through canvases, scrollback (including packed and spilled lines),
+            //     text pages and DirectVT peers, and a cluster dropped while still referenced is blanked for good (DirectVT clients request it from the store again).
             static auto jumbos()
             {
                 static auto cache = netxs::generics::cache<text>{};
@@ -2314,6 +2511,52 @@ namespace netxs
         {
             return !operator==(c);
         }
+        // cell: Return the length of the leading run of equal cells (the vectorized operator == for cell sequences).
+        static auto equal_run(cell const* a, cell const* b, size_t count)
+        {
+            auto n = size_t{ 0 };
+            #if defined(VTM_SIMD_SSE2)
+            static_assert(sizeof(cell) == 40 && sizeof(id_t) == 4 && offsetof(cell, id) == 36); // The link id is the only field excluded from comparison.
+            auto pa = reinterpret_cast<char const*>(a);
+            auto pb = reinterpret_cast<char const*>(b);
+                #if defined(VTM_SIMD_AVX2)
+                auto wide_1 = _mm256_setr_epi32(0, -1, 0,  0, 0,  0, 0,  0); // Four cells per 5x32 bytes. Mask out cell::id at bytes 36, 76, 116 and 156.
+                auto wide_2 = _mm256_setr_epi32(0,  0, 0, -1, 0,  0, 0,  0);
+                auto wide_3 = _mm256_setr_epi32(0,  0, 0,  0, 0, -1, 0,  0);
+                auto wide_4 = _mm256_setr_epi32(0,  0, 0,  0, 0,  0, 0, -1);
+                auto eq_256 = [&](auto offset){ return _mm256_cmpeq_epi32(_mm256_loadu_si256((__m256i const*)(pa + offset)), _mm256_loadu_si256((__m256i const*)(pb + offset))); };
+                while (n + 4 <= count)
+                {
+                    auto eq = _mm256_and_si256(_mm256_and_si256(eq_256(0),
+                                                                _mm256_or_si256(eq_256(32), wide_1)),
+                                               _mm256_and_si256(_mm256_and_si256(_mm256_or_si256(eq_256(64), wide_2),
+                                                                                 _mm256_or_si256(eq_256(96), wide_3)),
+                                                                _mm256_or_si256(eq_256(128), wide_4)));
+                    if (_mm256_movemask_epi8(eq) != -1) break;
+                    n += 4;
+                    pa += 160;
+                    pb += 160;
+                }
+                #endif
+            auto skip_2 = _mm_setr_epi32(0, -1, 0,  0); // Two cells per 5x16 bytes. Mask out cell::id at bytes 36 and 76.
+            auto skip_4 = _mm_setr_epi32(0,  0, 0, -1);
+            auto eq_128 = [&](auto offset){ return _mm_cmpeq_epi32(_mm_loadu_si128((__m128i const*)(pa + offset)), _mm_loadu_si128((__m128i const*)(pb + offset))); };
+            while (n + 2 <= count)
+            {
+                auto eq = _mm_and_si128(_mm_and_si128(eq_128(0),
+                                                      eq_128(16)),
+                                        _mm_and_si128(_mm_and_si128(_mm_or_si128(eq_128(32), skip_2),
+                                                                    eq_128(48)),
+                                                      _mm_or_si128(eq_128(64), skip_4)));
+                if (_mm_movemask_epi8(eq) != 0xFFFF) break;
+                n += 2;
+                pa += 80;
+                pb += 80;
+            }
+            #endif
+            while (n < count && a[n] == b[n]) n++;
+            return n;
+        }
         auto& operator = (cell const& c)
         {
             uv = c.uv;
@@ -3336,6 +3579,11 @@ namespace netxs
                     {
                         f(dst, brush);
                     }
+                    template<class D>
+                    inline void batch(D* head, D* tail) const requires requires{ Func::batch(head, tail, brush); } // Process a contiguous span at once.
+                    {
+                        Func::batch(head, tail, brush);
+                    }
                 };
             };
 
@@ -3406,11 +3654,13 @@ namespace netxs
             {
                 template<class C> constexpr inline auto operator () (C brush) const { return func<C>(brush); }
                 template<class D, class S>  inline void operator () (D& dst, S& src) const { dst.mix(src); }
+                static void batch(argb* head, argb* tail, argb c) { argb::blend(head, tail, c); }
             };
             struct blend_t : public brush_t<blend_t>
             {
                 template<class C> constexpr inline auto operator () (C brush) const { return func<C>(brush); }
                 template<class D, class S>  inline void operator () (D& dst, S& src) const { dst.blend(src); }
+                static void batch(argb* head, argb* tail, argb c) { argb::blend(head, tail, c); }
             };
             struct blendpma_t : public brush_t<blendpma_t>
             {
@@ -3421,11 +3671,13 @@ namespace netxs
             {
                 template<class C> constexpr inline auto operator () (C brush) const { return func<C>(brush); }
                 template<class D, class S>  inline void operator () (D& dst, S& src) const { dst.alpha_sum(src); }
+                static void batch(argb* head, argb* tail, std::integral auto k) { argb::alpha_sum(head, tail, k); }
             };
             struct alphamix_t : public brush_t<alphamix_t>
             {
                 template<class C> constexpr inline auto operator () (C brush) const { return func<C>(brush); }
                 template<class D, class S>  inline void operator () (D& dst, S& src) const { argb::alpha_mix(src, dst); }
+                static void batch(byte* head, byte* tail, std::integral auto src) { argb::alpha_mix(head, tail, src); }
             };
             struct full_t : public brush_t<full_t>
             {
@@ -4195,6 +4447,65 @@ namespace netxs
             dest.size(region.size);
             dest.canvas = canvas;
         }
+        void copy(core const& source, regs const& damage) // core: Copy the damaged regions of the same-sized source canvas.
+        {
+            assert(region.size == source.region.size);
+            auto full = rect{ dot_00, region.size };
+            for (auto r : damage)
+            {
+                r.trimby(full);
+                if (!r) continue;
+                auto src = source.canvas.begin() + r.coor.x + r.coor.y * region.size.x;
+                auto dst = canvas.begin() + r.coor.x + r.coor.y * region.size.x;
+                for (auto y = 0; y < r.size.y; y++)
+                {
+                    std::copy(src, src + r.size.x, dst);
+                    src += region.size.x;
+                    dst += region.size.x;
+                }
+            }
+        }
+        void sync(core const& source, regs& damage) // core: Take the changed cells of the same-sized source canvas and append the changed row spans to the damage list.
+        {
+            assert(region.size == source.region.size);
+            auto width = region.size.x;
+            auto src = source.canvas.data();
+            auto dst = canvas.data();
+            for (auto y = 0; y < region.size.y; y++)
+            {
+                auto from = width;
+                auto upto = 0;
+                auto x = 0;
+                while (true)
+                {
+                    x += (si32)cell::equal_run(src + x, dst + x, width - x);
+                    if (x == width) break;
+                    from = std::min(from, x);
+                    do dst[x] = src[x];
+                    while (++x != width && src[x] != dst[x]);
+                    upto = x;
+                }
+                if (from < upto)
+                {
+                    if (damage.size())
+                    {
+                        auto& last = damage.back();
+                        if (last.coor.x == from && last.size.x == upto - from && last.coor.y + last.size.y == y) // Merge vertically adjacent spans.
+                        {
+                            last.size.y++;
+                            from = upto;
+                        }
+                    }
+                    if (from < upto) damage.push_back({{ from, y }, { upto - from, 1 }});
+                }
+                src += width;
+                dst += width;
+            }
+            region.coor = source.region.coor;
+            client = source.client;
+            marker = source.marker;
+            hasimg = source.hasimg;
+        }
         void copy(core& target, auto fx) const // core: Copy the canvas to the specified target bitmap. The target bitmap must be the same size.
         {
             netxs::oncopy(target, *this, fx);
@@ -4464,6 +4775,71 @@ namespace netxs::misc
                                                                      d_point, shade);
     }
 
+    // misc: netxs::boxblur of the cell backgrounds (ratio 2) with the vertical pass done row by row using the batched irgb kernels.
+    //       The column-by-column pass strides over the whole bitmap for every column. The result is the same as of netxs::boxblur.
+    template<bool InnerGlow = faux, class P = noop>
+    void boxblur_bgc(auto s_ptr, vrgb& cache, si32 w, si32 h, si32 r, si32 s_width, P shade = {})
+    {
+        using irgb = vrgb::value_type;
+        if (h <= 0 || w <= 0 || r <= 0) return;
+        auto rx = r * 2;
+        auto ry = r;
+        auto r1 = ry + 1;
+        auto count = (rx + rx + 1) * (ry + ry + 1);
+        auto s = (size_t)w * h;
+        if (cache.size() < s + 3 * (size_t)w)
+        {
+            cache.resize(s + 3 * (size_t)w);
+        }
+        auto d_ptr = cache.data();
+        auto s_point = [](auto c)->auto& { return c->bgc(); };
+        auto d_point = [](auto c)->auto& { return *c;       };
+        if (h <= r1 || count > (1 << 24) / 256) // All pixels in a column have the same average value, or the sums are not exact in floats.
+        {
+            netxs::boxblur<irgb, InnerGlow>(s_ptr, d_ptr, w, h, r, s_width, w, 2, s_point, d_point, shade);
+            return;
+        }
+        netxs::boxblur1d<irgb, InnerGlow, 0>(s_ptr, d_ptr, w, h, rx, 1, s_width, 1, w, rx + rx + 1, s_point, d_point); // Horizontal pass to the cache.
+        auto accum = d_ptr + s;
+        auto l_val = accum + w; // The values beyond the top and bottom edges.
+        auto r_val = l_val + w;
+        auto row = [&](si32 y){ return d_ptr + (size_t)y * w; };
+        auto ext = [&](si32 y){ return y < 0 ? l_val : y >= h ? r_val : row(y); };
+        std::fill(accum, accum + w, irgb{});
+        std::fill(r_val, r_val + w, irgb{});
+        for (auto y = 0; y < r1; y++) irgb::slide(accum, accum + w, row(y), r_val);
+        for (auto x = 0; x < w; x++)
+        {
+            if constexpr (InnerGlow)
+            {
+                l_val[x] = row(0)[x];
+                r_val[x] = row(h - 1)[x];
+            }
+            else
+            {
+                l_val[x] = accum[x] / r1;
+                for (auto y = h - r1; y < h; y++) r_val[x] += row(y)[x];
+                r_val[x] /= r1;
+            }
+            accum[x] += l_val[x] * ry;
+        }
+        auto chunk = std::array<argb, 64>{};
+        for (auto y = 0; y < h; y++)
+        {
+            auto dest = s_ptr + (ptrdiff_t)y * s_width;
+            for (auto x = 0; x < w; x += (si32)chunk.size())
+            {
+                auto n = std::min(w - x, (si32)chunk.size());
+                irgb::average(accum + x, accum + x + n, count, chunk.data());
+                for (auto c : std::span{ chunk.data(), (size_t)n })
+                {
+                    dest->bgc() = c;
+                    shade(*dest++);
+                }
+            }
+            if (y + 1 < h) irgb::slide(accum, accum + w, ext(y + 1 + ry), ext(y - ry));
+        }
+    }
     void contour(auto& image)
     {
         static auto shadows_cache = netxs::raw_vector<fp32>{};
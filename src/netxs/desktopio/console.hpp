@@ -54,10 +54,13 @@ namespace netxs::ui
     {
         flag active; // pipe: Is connected.
         flag isbusy; // pipe: Buffer is still busy.
+        directvt::binary::packer packer; // pipe: Outgoing stream compressor (enabled when negotiated, see binary::features).
+        std::atomic<ui32> extras; // pipe: Negotiated protocol extensions (binary::feature::*).
 
         pipe(bool active)
             : active{ active },
-              isbusy{ faux   }
+              isbusy{ faux   },
+              extras{ 0      }
         { }
         virtual ~pipe()
         { }
@@ -87,7 +90,8 @@ namespace netxs::ui
         virtual std::ostream& show(std::ostream& s) const = 0;
         void output(view data)
         {
-            send(data);
+            if (packer) packer.output(data, [&](view block){ send(block); });
+            else        send(data);
         }
         friend auto& operator << (std::ostream& s, pipe const& sock)
         {
@@ -306,6 +310,27 @@ namespace netxs::ui
                     };
                 }
             }
+            void handle(s11n::xs::features    lock)
+            {
+                auto& item = lock.thing;
+                auto accepted = item.flags & (directvt::binary::feature::packed | directvt::binary::feature::runs | directvt::binary::feature::rstat);
+                auto state = !!(accepted & directvt::binary::feature::packed);
+                canal.extras = accepted; // The renderer picks it up with the next frame.
+                if (state != !!canal.packer)
+                {
+                    canal.packer.enable(state);
+                    log("%%Stream compression %state%", prompt::gate, state ? "enabled" : "disabled");
+                }
+                item.set(accepted); // Reply with the accepted extensions.
+                item.sendby(canal);
+            }
+            void handle(s11n::xs::rasterstat  lock)
+            {
+                owner.base::enqueue([&, stats = lock.thing](auto& /*boss*/)
+                {
+                    owner.debug.update(stats.frames, stats.average, stats.longest, stats.bytes, stats.banks, stats.hits, stats.misses, stats.evictions);
+                });
+            }
             void handle(s11n::xs::fps         lock)
             {
                 auto& item = lock.thing;
@@ -349,90 +374,172 @@ namespace netxs::ui
             {
                 span watch{}; // diff::stat: Rendering duration.
                 sz_t delta{}; // diff::stat: Last rendered frame size.
+                si64 dropped{}; // diff::stat: Number of frames superseded before being rendered.
+                span latency{}; // diff::stat: Delay between frame publication and its pickup by the renderer.
+                span rtt{}; // diff::stat: Smoothed frame delivery time (from sending to the link release).
+                si64 rate{}; // diff::stat: Smoothed link throughput in bytes per second.
+                si64 depth{}; // diff::stat: Frames published while the last frame was in flight.
+                si32 fps{}; // diff::stat: Effective frame rate (delivered frames per second).
+                span pace{}; // diff::stat: Min interval between published frames the link can take.
+            };
+            struct slot
+            {
+                core canvas; // diff::slot: Frame buffer.
+                regs stale; // diff::slot: Regions lagging behind the latest published frame.
             };
 
             pipe& canal; // diff: Channel to outside.
-            lock  mutex; // diff: Mutex between renderer and committer threads.
+            lock  mutex; // diff: Mutex for swapping frame buffers between renderer and committer threads.
             cond  synch; // diff: Synchronization between renderer and committer.
-            core  cache; // diff: The current content buffer which going to be checked and processed.
+            slot  queue[3]; // diff: Frame buffers.
+            slot* spare; // diff: Frame buffer owned by the committer.
+            slot* fresh; // diff: The latest published frame buffer.
+            slot* front; // diff: Frame buffer owned by the renderer.
+            regs  delta; // diff: Damaged regions of the frame being published.
+            regs  dirty; // diff: Damaged regions of the published frames that have not been picked up yet.
+            time  stamp; // diff: Publication time of the fresh frame.
+            si64  count; // diff: Number of published frames.
+            std::atomic<si64> posted; // diff: Number of published frames (for the renderer).
+            std::atomic<span> pacing; // diff: Smoothed frame cycle of the renderer, used to pace the committer.
             flag  alive; // diff: Working loop state.
             flag  ready; // diff: Conditional variable to avoid spurious wakeup.
             flag  abort; // diff: Abort building current frame.
             work  paint; // diff: Rendering thread.
-            stat  debug; // diff: Debug info.
+            stat  debug; // diff: Debug info (owned by the renderer).
+            stat  shown; // diff: Debug info snapshot published under the mutex at the end of each rendering cycle.
 
+            // diff: Merge the damage list into the destination and keep it compact.
+            static void merge(regs& dest, regs const& damage, si32 limit)
+            {
+                dest.insert(dest.end(), damage.begin(), damage.end());
+                if (dest.size() > (size_t)limit)
+                {
+                    auto area = dest.front();
+                    for (auto& r : dest) area |= r;
+                    dest.assign(1, area);
+                }
+            }
             // diff: Render current buffer.
             template<class Bitmap>
             void render()
             {
                 if constexpr (debugmode) log(prompt::diff, "Rendering thread started", ' ', utf::to_hex_0x(std::this_thread::get_id()));
                 auto start = time{};
+                auto epoch = datetime::now();
+                auto tally = 0;
+                auto cycle = span{};
                 auto image = Bitmap{};
+                auto damage = regs{};
                 auto guard = std::unique_lock{ mutex };
                 while ((void)synch.wait(guard, [&]{ return !!ready; }), alive)
                 {
                     start = datetime::now();
                     ready = faux;
                     abort = faux;
+                    std::swap(front, fresh);
+                    std::swap(damage, dirty);
+                    debug.latency = start - stamp;
+                    auto taken = posted.load();
+                    guard.unlock(); // The committer never waits for the renderer.
+                    auto& cache = front->canvas;
                     auto winid = id_t{ 0xddccbbaa };
                     auto coord = dot_00;
-                    image.set(winid, coord, cache, abort, debug.delta);
+                    if constexpr (requires{ image.runs; }) image.runs = !!(canal.extras & directvt::binary::feature::runs);
+                    image.set(winid, coord, cache, damage, abort, debug.delta);
                     if (debug.delta)
                     {
-                        guard.unlock(); // Allow to abort.
+                        auto s = datetime::now();
                         canal.isbusy = true; // It's okay if someone resets the busy flag before sending.
                         image.sendby(canal);
-                        canal.isbusy.wait(true); // Successive frames must be discarded until the current frame is delivered (to prevent unlimited buffer growth).
-                        guard.lock();
+                        canal.isbusy.wait(true); // Successive frames are superseded until the current frame is delivered (to prevent unlimited buffer growth).
+                        auto f = datetime::now();
+                        auto trip = f - s;
+                        auto rate = (si64)debug.delta * span::period::den / span::period::num / std::max(span::rep{ 1 }, trip.count());
+                        debug.rtt = debug.rtt == span::zero() ? trip : (debug.rtt * 7 + trip) / 8;
+                        debug.rate = debug.rate ? (debug.rate * 7 + rate) / 8 : rate;
+                        debug.depth = posted.load() - taken;
+                        tally++;
+                        if (f - epoch >= 1s)
+                        {
+                            debug.fps = (si32)(tally * 1s / (f - epoch));
+                            epoch = f;
+                            tally = 0;
+                        }
                     }
+                    guard.lock();
+                    if (abort) merge(dirty, damage, cache.size().y); // The frame has been discarded.
+                    damage.clear();
                     debug.watch = datetime::now() - start;
+                    cycle = cycle == span::zero() ? debug.watch : (cycle * 7 + debug.watch) / 8;
+                    debug.pace = std::min(cycle, span{ 1s }); // At least one frame per second for the slowest links.
+                    pacing = debug.pace;
+                    shown = debug;
                 }
                 if constexpr (debugmode) log(prompt::diff, "Rendering thread ended", ' ', utf::to_hex_0x(std::this_thread::get_id()));
             }
             // diff: Get rendering statistics.
             auto status()
             {
-                return debug;
+                auto guard = std::lock_guard{ mutex };
+                auto stats = shown;
+                stats.dropped = debug.dropped; // Counted by the committer under the mutex.
+                return stats;
+            }
+            // diff: Return true if the link has not yet taken the previous frames at the current rate.
+            //       The committer skips the frame and the damage keeps accumulating in the meantime.
+            auto defer(time now)
+            {
+                return count && now - stamp < pacing.load();
             }
             // diff: Discard current frame.
             void cancel()
             {
                 abort = true;
             }
-            // diff: Try to add the touched canvas image to the queue for analysis and sending detected differences.
+            // diff: Publish the touched canvas image for analysis and sending detected differences.
             auto send(core const& canvas)
             {
-                if (abort)
+                auto& next = *spare;
+                auto area = rect{ dot_00, canvas.size() };
+                delta.clear();
+                if (next.canvas.hash() != canvas.hash() || next.canvas.size() != canvas.size())
                 {
-                    while (alive) // Try to send a new frame as soon as possible (e.g. after resize).
-                    {
-                        auto lock = std::unique_lock{ mutex, std::try_to_lock };
-                        if (lock.owns_lock())
-                        {
-                            cache = canvas;
-                            ready = true;
-                            synch.notify_one();
-                            return true;
-                        }
-                        else std::this_thread::yield();
-                    }
+                    next.canvas = canvas;
+                    delta.assign(1, area);
                 }
                 else
                 {
-                    auto lock = std::unique_lock{ mutex, std::try_to_lock };
-                    if (lock.owns_lock())
-                    {
-                        cache = canvas;
-                        ready = true;
-                        synch.notify_one();
-                        return true;
-                    }
+                    next.canvas.copy(canvas, next.stale); // Catch up with the latest published frame.
+                    std::swap(delta, next.stale);
+                    next.canvas.sync(canvas, delta);
+                    merge(delta, {}, area.size.y);
+                }
+                next.stale.clear();
+                if (delta.empty() && !abort) return true; // Nothing has changed.
+                for (auto& s : queue)
+                {
+                    if (&s != spare) merge(s.stale, delta, area.size.y);
                 }
-                return faux;
+                auto guard = std::lock_guard{ mutex };
+                if (abort) dirty.assign(1, area);
+                else       merge(dirty, delta, area.size.y);
+                if (ready) debug.dropped++; // The previous frame has not been picked up yet.
+                std::swap(spare, fresh);
+                stamp = datetime::now();
+                posted = ++count;
+                ready = true;
+                synch.notify_one();
+                return true;
             }
 
             diff(pipe& dest, svga vtmode)
                 : canal{ dest },
+                  spare{ &queue[0] },
+                  fresh{ &queue[1] },
+                  front{ &queue[2] },
+                  count{ 0 },
+                  posted{ 0 },
+                  pacing{ span::zero() },
                   alive{ true },
                   ready{ faux },
                   abort{ faux }
@@ -798,8 +905,9 @@ namespace netxs::ui
         }
 
         // gate: .
-        void rebuild_scene(time stamp)
+        void rebuild_scene(time stamp, bool forced = faux)
         {
+            if (!forced && paint.defer(stamp)) return; // Pace frames to the link throughput.
             auto damaged = base::ruined();
             if (props.tooltip_enabled)
             {
@@ -878,14 +986,20 @@ namespace netxs::ui
                 }
                 if (yield) return;
             }
-            yield = paint.send(canvas); // Try to output updated canvas if paint is not busy.
+            yield = paint.send(canvas); // Publish updated canvas.
 
             if (props.debug_overlay) // Get rendering stats.
             {
                 if (yield)
                 {
                     auto d = paint.status();
-                    debug.update(d.watch, d.delta);
+                    debug.update(d.watch, d.delta, d.dropped, d.latency);
+                    debug.update(d.rtt, d.rate, d.depth, d.fps, d.pace);
+                    if (canal.packer)
+                    {
+                        auto z = canal.packer.status();
+                        debug.update(z.source, z.output, z.worked);
+                    }
                 }
                 debug.update(stamp);
             }
@@ -1408,7 +1522,7 @@ namespace netxs::ui
                     paint.cancel();
                 }
                 auto timestamp = datetime::now(); // Do not wait next timer tick.
-                rebuild_scene(timestamp);
+                rebuild_scene(timestamp, true);
             };
             LISTEN(tier::general, e2::timer::any, timestamp)
             {
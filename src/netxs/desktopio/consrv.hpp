@@ -5127,12 +5127,21 @@ struct impl : consrv
 
 struct consrv : ipc::stdcon
 {
-    std::thread stdinput{};
-    pidt        group_id{};
+    std::thread           stdinput{};
+    pidt                  group_id{};
+    bool                  reactor{}; // consrv: Read the PTY output in the shared os::io::reactor thread.
+    ui64                  watching{}; // consrv: os::io::reactor registration.
+    std::function<void()> finalize{}; // consrv: Trailer to run when the output ends.
 
     template<class Term>
-    consrv(Term&)
-    { }
+    consrv(Term& terminal)
+    {
+        #if defined(__linux__)
+        reactor = terminal.defcfg.def_poller;
+        #else
+        (void)terminal;
+        #endif
+    }
 
     bool alive() const
     {
@@ -5140,10 +5149,19 @@ struct consrv : ipc::stdcon
     }
     void cleanup(bool io_log)
     {
+        #if defined(__linux__)
+        if (watching)
+        {
+            if (os::io::reactor::detach(std::exchange(watching, 0))) // The output has not ended yet: the trailer has not been started.
+            {
+                finalize();
+            }
+        }
+        #endif
         if (stdinput.joinable())
         {
             if (io_log) log(prompt::vtty, "Reading thread joining", ' ', utf::to_hex_0x(stdinput.get_id()));
-            stdcon::abort(stdinput);  // On Linux: thread::join sometimes dead waits on recv() call (repro: Create multiuser session, run term with bash, run vim inside, refocus, close window by 'x').
+            if (!reactor) stdcon::abort(stdinput); // On Linux: thread::join sometimes dead waits on recv() call (repro: Create multiuser session, run term with bash, run vim inside, refocus, close window by 'x'). In reactor mode the thread only runs the trailer.
             stdinput.join();
         }
         stdcon::cleanup();
@@ -5159,16 +5177,12 @@ struct consrv : ipc::stdcon
     void read_socket_thread(Term& terminal)
     {
         if (terminal.io_log) log(prompt::vtty, "Reading thread started", ' ', utf::to_hex_0x(stdinput.get_id()));
-        auto flow = text{};
         while (alive())
         {
             auto shot = stdcon::recv();
             if (shot && alive())
             {
-                flow += shot;
-                auto crop = ansi::purify(flow);
-                terminal.ondata(crop);
-                flow.erase(0, crop.size()); // Delete processed data.
+                terminal.ingest(shot); // The output is parsed in batches outside of this thread.
             }
             else break;
         }
@@ -5186,11 +5200,39 @@ struct consrv : ipc::stdcon
         auto rc1 = os::syscall{ ::grantpt(fdm.value)              }; // Grant master TTY file access.
         auto rc2 = os::syscall{ ::unlockpt(fdm.value)             }; // Unlock master TTY.
         stdcon::start(fdm.value);
-        stdinput = std::thread{ [&, trailer]
+        #if defined(__linux__)
+        if (reactor)
         {
-            read_socket_thread(terminal);
-            trailer();
-        }};
+            finalize = trailer;
+            watching = os::io::reactor::attach(fdm.value, [&]
+            {
+                auto shot = stdcon::recv(); // Level-triggered readiness: a single read does not block.
+                if (shot && alive())
+                {
+                    auto token = os::io::reactor::current();
+                    if (!terminal.ingest(shot, [token]{ os::io::reactor::resume(token); })) // The shared thread never waits for the parser.
+                    {
+                        os::io::reactor::pause(); // Stop reading until the parser drains the backlog.
+                    }
+                    return true;
+                }
+                else return faux;
+            },
+            [&]
+            {
+                stdinput = std::thread{ finalize }; // The trailer waits for the processes to exit.
+            });
+        }
+        if (!watching)
+        #endif
+        {
+            reactor = faux;
+            stdinput = std::thread{ [&, trailer]
+            {
+                read_socket_thread(terminal);
+                trailer();
+            }};
+        }
         auto pid = os::syscall{ os::process::sysfork() };
         if (pid.value == 0) // Child branch.
         {
@@ -2935,6 +2935,7 @@ namespace netxs::ui
             si32 width; // acryl: Blur radius.
             bool alive; // acryl: Is active.
             vrgb cache; // acryl: Boxblur temp buffer.
+            blur_memo haze; // acryl: Previous blur source and result.
 
         public:
             acryl(base&&) = delete;
@@ -2947,6 +2948,10 @@ namespace netxs::ui
                 {
                     alive = state;
                 };
+                boss.LISTEN(tier::request, e2::form::prop::ui::acryl, state, memo)
+                {
+                    state |= alive;
+                };
                 boss.LISTEN(tier::anycast, e2::form::prop::lucidity, lucidity, memo)
                 {
                     if (lucidity != -1) alive = lucidity == 0xFF;
@@ -2954,7 +2959,7 @@ namespace netxs::ui
                 boss.LISTEN(tier::release, e2::render::background::prerender, parent_canvas, memo)
                 {
                     if (!alive) return;
-                    parent_canvas.blur(width, cache, [&](cell& c){ c.alpha(0xFF); });
+                    parent_canvas.blur(width, haze, cache, [&](cell& c){ c.alpha(0xFF); });
                 };
             }
         };
@@ -3251,6 +3256,15 @@ namespace netxs::ui
             X(render_ns    , "stdout time"      ) \
             X(frame_size   , "frame size"       ) \
             X(frame_rate   , "frame rate"       ) \
+            X(frame_drops  , "dropped frames"   ) \
+            X(link_stat    , "link"             ) \
+            X(swap_latency , "swap latency"     ) \
+            X(lock_waits   , "ui lock waits"    ) \
+            X(lock_hist    , "ui lock wait hist") \
+            X(jumbo_store  , "jumbo clusters"   ) \
+            X(compression  , "compression"      ) \
+            X(gui_raster   , "gui raster"       ) \
+            X(glyph_cache  , "gui glyph cache"  ) \
             X(focused      , "focus"            ) \
             X(win_size     , "win size"         ) \
             X(key_code     , "key virt"         ) \
@@ -3303,6 +3317,16 @@ namespace netxs::ui
                 si32 frsize = 0;
                 si64 totals = 0;
                 si32 number = 0;    // info: Current frame number
+                si64 dropped = 0;   // info: Frames superseded before being rendered.
+                span latency = span::zero(); // info: Frame buffer swap latency.
+                si64 source = 0;    // info: Stream bytes before compression.
+                si64 packed = 0;    // info: Stream bytes after compression.
+                span packer = span::zero(); // info: Time spent on compression.
+                span rtt = span::zero(); // info: Frame delivery time.
+                si64 rate = 0;      // info: Link throughput (bytes per second).
+                si64 depth = 0;     // info: Frames published while the last frame was in flight.
+                si32 fps = 0;       // info: Effective frame rate.
+                span pace = span::zero(); // info: Frame pacing interval.
             }
             track; // debug: Telemetry data.
 
@@ -3316,11 +3340,32 @@ namespace netxs::ui
                 status[prop::last_event] = "size";
                 status[prop::win_size] = utf::concat(new_size.x, " x ", new_size.y);
             }
-            void update(span watch, si32 delta)
+            void update(span watch, si32 delta, si64 dropped, span latency)
             {
                 track.output = watch;
                 track.frsize = delta;
                 track.totals+= delta;
+                track.dropped = dropped;
+                track.latency = latency;
+            }
+            void update(span rtt, si64 rate, si64 depth, si32 fps, span pace)
+            {
+                track.rtt = rtt;
+                track.rate = rate;
+                track.depth = depth;
+                track.fps = fps;
+                track.pace = pace;
+            }
+            void update(si64 source, si64 packed, span packer)
+            {
+                track.source = source;
+                track.packed = packed;
+                track.packer = packer;
+            }
+            void update(si32 frames, si64 average, si64 longest, si64 bytes, si32 banks, si64 hits, si64 misses, si64 evictions)
+            {
+                status[prop::gui_raster] = utf::concat(frames, " frames, avg ", utf::format(average), "us, max ", utf::format(longest), "us");
+                status[prop::glyph_cache] = utf::concat(utf::format(bytes / 1024), " KiB in ", banks, " banks, hits ", utf::format(hits), ", misses ", utf::format(misses), ", evictions ", utf::format(evictions));
             }
             void update(time timestamp)
             {
@@ -3332,6 +3377,24 @@ namespace netxs::ui
                 status[prop::proceed_ns] = utf::adjust(utf::format (track.render.count()), 11, " ", true) + "ns";
                 status[prop::frame_size] = utf::adjust(utf::format(track.frsize), 7, " ", true) + " bytes";
                 status[prop::total_size] = utf::format(track.totals) + " bytes";
+                status[prop::frame_drops] = utf::format(track.dropped);
+                status[prop::link_stat] = utf::concat("rtt ", utf::format(datetime::round<si64, std::chrono::microseconds>(track.rtt)), "us, ",
+                                                      utf::format(track.rate / 1024), " KiB/s, queue ", track.depth, ", ",
+                                                      track.fps, " fps, pace ", utf::format(datetime::round<si64, std::chrono::microseconds>(track.pace)), "us");
+                status[prop::swap_latency] = utf::adjust(utf::format(track.latency.count()), 11, " ", true) + "ns";
+                auto& gauge = boss.indexer.mutex;
+                auto taken = (si64)gauge.taken.load(std::memory_order_relaxed);
+                auto waits = (si64)gauge.waits.load(std::memory_order_relaxed);
+                auto spent = (si64)gauge.spent.load(std::memory_order_relaxed);
+                status[prop::lock_waits] = utf::concat(utf::format(waits), " of ", utf::format(taken), ", ", utf::format(waits ? spent / waits : 0), "ns avg");
+                static constexpr auto bin_names = std::to_array({ "<1us:", " <10us:", " <100us:", " <1ms:", " <10ms:", " <100ms:", " more:" });
+                auto hist = text{};
+                for (auto i = 0; i < gauge.bins; i++) hist += bin_names[i] + std::to_string(gauge.hist[i].load(std::memory_order_relaxed));
+                status[prop::lock_hist] = hist;
+                auto [jgc_count, jgc_bytes] = cell::glyf::jumbos().usage();
+                status[prop::jumbo_store] = utf::concat(utf::format(jgc_count), " entries, ", utf::format(jgc_bytes / 1024), " KiB");
+                status[prop::compression] = track.source ? utf::concat(utf::format(track.source), " -> ", utf::format(track.packed), " bytes, ", utf::format(track.packer.count() / 1000), "us")
+                                                         : "off"s;
                 track.number++;
                 status.reindex();
                 auto ctx = canvas.change_basis(canvas.area());
@@ -77,6 +77,13 @@ namespace netxs::directvt
 
         static constexpr auto is_list = type{ 1 << (sizeof(type) * 8 - 1) };
 
+        namespace feature // Protocol extensions negotiated by the features frame. A peer that does not know the frame ignores it, so the extensions stay off.
+        {
+            static constexpr auto packed = ui32{ 1 << 0 }; // Compressed frames (see binary::packer).
+            static constexpr auto runs   = ui32{ 1 << 1 }; // Image runs in bitmap_dtvt (see bitmap_dtvt_t::subtype::seq).
+            static constexpr auto rstat  = ui32{ 1 << 2 }; // Rasterization stats of the GUI client (see rasterstat).
+        }
+
         struct blob : public view
         { };
 
@@ -538,26 +545,78 @@ namespace netxs::directvt
                 auto crop = qiew(head, iter - head);
                 return crop;
             }
-            // stream: .
-            template<class T, class P, bool Plain = std::is_same_v<void, std::invoke_result_t<P, qiew>>>
-            static void reading_loop(T& link, P&& proc)
+            // stream: Incremental frame reader. Whole frames are passed in place from the link's receive buffer. Only a frame
+            //         split between reads is carried over, and the rest of it is received straight into the carry buffer
+            //         once its size is known.
+            struct reader
             {
-                auto flow = text{};
-                while (link)
+                text   flow; // reader: Buffer for the frame split between reads (only grows).
+                size_t used{}; // reader: Bytes of the split frame received so far.
+
+                auto need()
+                {
+                    return used < sizeof(sz_t) ? sizeof(sz_t) : (size_t)netxs::aligned<sz_t>(flow.data());
+                }
+                // reader: Move the split frame bytes from data to flow. The frame size is checked and flow is sized for
+                //         the whole frame as soon as the size header is complete (the rest may be received directly).
+                bool fill(view& data)
                 {
-                    auto shot = link.recv();
-                    if (shot && link)
+                    while (true)
                     {
-                        flow += shot;
-                        if (auto crop = purify(flow))
+                        auto size = need();
+                        if (size < sizeof(sz_t))
                         {
-                            if constexpr (Plain) proc(crop);
-                            else            if (!proc(crop)) break;
-                            flow.erase(0, crop.size()); // Delete processed data.
+                            log(prompt::dtvt, "Stream corrupted, frame size: ", size);
+                            return faux;
                         }
+                        if (flow.size() < size) flow.resize(size);
+                        if (size == used || data.empty()) break;
+                        auto count = std::min(size - used, data.size());
+                        ::memcpy(flow.data() + used, data.data(), count);
+                        used += count;
+                        data.remove_prefix(count);
                     }
-                    else break;
+                    return true;
                 }
+                // reader: Receive once from the link and pass the completed frames to proc. Return faux to stop reading.
+                //         A single receive call does not block when the link is known to be readable.
+                template<class T, class P, bool Plain = std::is_same_v<void, std::invoke_result_t<P, qiew>>>
+                bool step(T& link, P&& proc)
+                {
+                    auto direct = used >= sizeof(sz_t);
+                    auto shot = direct ? link.recv(flow.data() + used, need() - used) // Receive the rest of the split frame in place.
+                                       : link.recv();
+                    if (!shot || !link) return faux;
+                    auto data = view{ shot };
+                    if (direct)
+                    {
+                        used += data.size();
+                        data = {};
+                    }
+                    else if (used && !fill(data)) return faux;
+                    if (used)
+                    {
+                        if (used < sizeof(sz_t) || used != need()) return true; // The split frame is still incomplete.
+                        auto crop = qiew{ flow.data(), used };
+                        used = 0;
+                        if constexpr (Plain) proc(crop);
+                        else            if (!proc(crop)) return faux;
+                    }
+                    if (auto crop = purify(data))
+                    {
+                        if constexpr (Plain) proc(crop);
+                        else            if (!proc(crop)) return faux;
+                        data.remove_prefix(crop.size());
+                    }
+                    return fill(data);
+                }
+            };
+            // stream: Read frames from the link and pass them to proc.
+            template<class T, class P>
+            static void reading_loop(T& link, P&& proc)
+            {
+                auto frames = reader{};
+                while (link && frames.step(link, proc));
             }
             // stream: .
             template<class T, class P>
@@ -907,10 +966,11 @@ namespace netxs::directvt
         #define DEFINE_macro
         #include "macrogen.hpp"
 
-        #define STRUCT_macro(struct_name, struct_members)                                   \
+        #define STRUCT_macro(struct_name, struct_members) STRUCT_macro_kind(struct_name, __COUNTER__ - _counter_base, struct_members)
+        #define STRUCT_macro_kind(struct_name, struct_kind, struct_members)                 \
             struct CAT_macro(struct_name, _t) : public stream                               \
             {                                                                               \
-                static constexpr auto kind = type{ __COUNTER__ - _counter_base };           \
+                static constexpr auto kind = type{ struct_kind };                           \
                 SEQ_ATTR_macro(WRAP_macro(struct_members))                                  \
                 CAT_macro(struct_name, _t)()                                                \
                     : stream{ kind }                                                        \
@@ -1079,13 +1139,263 @@ namespace netxs::directvt
         STRUCT_macro(img_element,        (ui16, index) (many, global_attributes)) // Reply image metadata list<img_element>. Access by imagens::gb::<attr_index>; The document_bits:(sub_id and document)+list_of_layers(index sub_id changed_bits attrs) is always placed at the end of the list.
         STRUCT_macro(update_img_request, (ui16, index) (si32, changed_bits) (many, changes)) // The document_bits:(sub_id and document)+list_of_layers(index sub_id changed_bits attrs) is always placed at the end of the list if set.
         STRUCT_macro(remove_img_request, (std::vector<ui16>, indexes))
+        // Extension frames. Their kinds are allocated downwards from is_list - 1 to keep the kinds of the frames above and below unchanged.
+        STRUCT_macro_kind(packed,   0x7F, (ui32, length) (blob, data)) // Compressed frames: length - unpacked size, data - LZ77 sequences.
+        STRUCT_macro_kind(features, 0x7E, (ui32, flags)) // Protocol extensions supported by the consumer (feature::*), sent right after the handshake. The producer replies with the accepted ones.
+        STRUCT_macro_kind(rasterstat, 0x7D, (si32, frames)     // rasterstat: Rasterized frames since the last report (sent once a second).
+                                            (si64, average)    // rasterstat: Average frame rasterization time (us).
+                                            (si64, longest)    // rasterstat: Longest frame rasterization time (us).
+                                            (si64, bytes)      // rasterstat: Glyph cache size.
+                                            (si32, banks)      // rasterstat: Glyph cache banks (font sizes).
+                                            (si64, hits)       // rasterstat: Glyph cache hits.
+                                            (si64, misses)     // rasterstat: Glyph cache misses.
+                                            (si64, evictions)) // rasterstat: Evicted glyphs.
 
         #undef STRUCT_macro
+        #undef STRUCT_macro_kind
         #undef STRUCT_macro_lite
         #define UNDEFINE_macro
         #include "macrogen.hpp"
 
+        // binary: LZ77 codec for the compressed frames (LZ4-like sequences: token, literals, 16-bit offset, match length).
+        //         The history of previously packed data is kept on both sides and serves as a shared dictionary across frames.
+        struct lz77
+        {
+            static constexpr auto window = 65535_sz; // lz77: Max match offset.
+            static constexpr auto minrun = 4_sz; // lz77: Min match length.
+
+            text hist; // lz77: Data history (the window and the current block).
+            si64 base; // lz77: Absolute position of the history beginning.
+
+            lz77()
+                : base{ 0 }
+            { }
+
+            // lz77: Keep no more than the window in the history.
+            void trim()
+            {
+                if (hist.size() > window * 4)
+                {
+                    auto drop = hist.size() - window;
+                    hist.erase(0, drop);
+                    base += drop;
+                }
+            }
+        };
+        // binary: Outgoing stream compressor.
+        struct packer : lz77
+        {
+            static constexpr auto hbits = 14; // packer: Hash table size.
+            static constexpr auto minsz = 256_sz; // packer: Blocks shorter than this are sent as is.
+            static constexpr auto ahead = sizeof(sz_t) + sizeof(type) + sizeof(ui32); // packer: Packed frame header size.
+
+            struct stat
+            {
+                si64 frames; // packer::stat: Number of sent blocks.
+                si64 packed; // packer::stat: Number of blocks sent compressed.
+                si64 source; // packer::stat: Total size of sent blocks.
+                si64 output; // packer::stat: Total size of sent data.
+                span worked; // packer::stat: Time spent on compression.
+            };
+
+            std::mutex        mutex; // packer: Ordering of the sent blocks.
+            flag              alive; // packer: Compression is enabled.
+            std::vector<si64> table; // packer: Last absolute positions of 4-byte hashes.
+            text              frame; // packer: Packed frame buffer.
+            stat              stats; // packer: Compression statistics.
+
+            packer()
+                : alive{ faux },
+                  stats{}
+            { }
+           ~packer()
+            {
+                if (stats.packed)
+                {
+                    log(prompt::dtvt, "Stream compression: ", stats.source, " -> ", stats.output, " bytes, ratio ", (fp64)stats.output / stats.source,
+                                      ", ", stats.packed, " of ", stats.frames, " blocks packed in ", stats.worked);
+                }
+            }
+            explicit operator bool () const { return alive; }
+
+            // packer: Enable/disable compression.
+            void enable(bool state)
+            {
+                auto guard = std::lock_guard{ mutex };
+                if (state && table.empty()) table.assign(1 << hbits, -1);
+                alive = state;
+            }
+            // packer: Get compression statistics.
+            auto status()
+            {
+                auto guard = std::lock_guard{ mutex };
+                return stats;
+            }
+            // packer: Pack the history tail starting from the specified offset into a frame.
+            void pack(size_t start)
+            {
+                auto data = hist.data();
+                auto tail = hist.size();
+                auto push = [&](size_t count)
+                {
+                    while (count >= 255)
+                    {
+                        frame.push_back('\xFF');
+                        count -= 255;
+                    }
+                    frame.push_back((char)count);
+                };
+                auto emit = [&](size_t from, size_t upto, size_t offset, size_t length) // length == 0 for the last literals.
+                {
+                    auto l = upto - from;
+                    auto m = length ? length - minrun : 0;
+                    frame.push_back((char)((std::min(l, 15_sz) << 4) | std::min(m, 15_sz)));
+                    if (l >= 15) push(l - 15);
+                    frame.append(data + from, l);
+                    if (length)
+                    {
+                        frame.push_back((char)(offset & 0xFF));
+                        frame.push_back((char)(offset >> 8));
+                        if (m >= 15) push(m - 15);
+                    }
+                };
+                auto load = [&](size_t at){ auto v = ui32{}; ::memcpy(&v, data + at, sizeof(v)); return v; };
+                auto hash = [&](ui32 v){ return (v * 2654435761u) >> (32 - hbits); };
+                auto anchor = start;
+                auto i = start;
+                while (i + minrun <= tail)
+                {
+                    auto v = load(i);
+                    auto& slot = table[hash(v)];
+                    auto from = slot - base; // May refer to the dropped or discarded data.
+                    slot = base + (si64)i;
+                    if (from >= 0 && (size_t)from < i && i - from <= window && load(from) == v)
+                    {
+                        auto f = (size_t)from;
+                        auto n = minrun;
+                        while (i + n < tail && data[f + n] == data[i + n]) n++;
+                        emit(anchor, i, i - f, n);
+                        i += n;
+                        anchor = i;
+                    }
+                    else i += 1 + ((i - anchor) >> 6); // Skip faster over incompressible data.
+                }
+                emit(anchor, tail, 0, 0);
+            }
+            // packer: Send the block compressed if it pays off.
+            void output(view block, auto send)
+            {
+                auto guard = std::lock_guard{ mutex };
+                stats.frames++;
+                stats.source += block.size();
+                if (!alive || block.size() < minsz)
+                {
+                    stats.output += block.size();
+                    send(block);
+                    return;
+                }
+                auto start = datetime::now();
+                trim();
+                auto head = hist.size();
+                hist += block;
+                frame.resize(ahead);
+                pack(head);
+                auto gain = frame.size() + block.size() / 16 < block.size();
+                if (gain)
+                {
+                    auto size = netxs::letoh((sz_t)frame.size());
+                    auto kind = packed_t::kind;
+                    auto full = netxs::letoh((ui32)block.size());
+                    ::memcpy(frame.data(), &size, sizeof(size));
+                    ::memcpy(frame.data() + sizeof(size), &kind, sizeof(kind));
+                    ::memcpy(frame.data() + sizeof(size) + sizeof(kind), &full, sizeof(full));
+                    stats.packed++;
+                }
+                else hist.resize(head); // The peer does not see the raw blocks.
+                stats.worked += datetime::now() - start;
+                auto data = gain ? view{ frame } : block;
+                stats.output += data.size();
+                send(data);
+            }
+        };
+        // binary: Incoming stream decompressor.
+        struct unpacker : lz77
+        {
+            // unpacker: Unpack the sequences and return the unpacked block.
+            auto unpack(view data, size_t length)
+            {
+                trim();
+                auto head = hist.size();
+                auto fail = [&]
+                {
+                    log(prompt::dtvt, "Corrupted compressed data");
+                    hist.resize(head);
+                    return view{};
+                };
+                if (length > data.size() * 255 + minrun) return fail(); // Reject lengths beyond the maximum expansion before allocating.
+                hist.resize(head + length);
+                auto dest = hist.data();
+                auto iter = head;
+                auto tail = head + length;
+                auto p = data.begin();
+                auto e = data.end();
+                auto read = [&](size_t count)
+                {
+                    if (count == 15)
+                    {
+                        auto c = 255;
+                        while (c == 255 && p != e)
+                        {
+                            c = (byte)*p++;
+                            count += c;
+                        }
+                    }
+                    return count;
+                };
+                while (p != e)
+                {
+                    auto token = (byte)*p++;
+                    auto l = read(token >> 4);
+                    if (l > (size_t)(e - p) || l > tail - iter) return fail();
+                    ::memcpy(dest + iter, &*p, l);
+                    iter += l;
+                    p += l;
+                    if (p == e) break; // The last literals.
+                    if (e - p < 2) return fail();
+                    auto offset = (size_t)(byte)p[0] | ((size_t)(byte)p[1] << 8);
+                    p += 2;
+                    auto n = read(token & 15) + minrun;
+                    if (offset == 0 || offset > iter || n > tail - iter) return fail();
+                    auto from = dest + iter - offset;
+                    auto to = dest + iter;
+                    if (offset >= n) ::memcpy(to, from, n);
+                    else             for (auto i = 0_sz; i < n; i++) to[i] = from[i]; // Overlapped run.
+                    iter += n;
+                }
+                if (iter != tail) return fail();
+                return view{ hist.data() + head, length };
+            }
+        };
+
         static const auto process_id = datetime::now();
+        // binary: Collect the damaged span (x: from, y: upto) of each row of the canvas of the specified size.
+        static void rowspans(regs const& damage, twod size, std::vector<twod>& spans)
+        {
+            spans.assign(size.y, twod{ size.x, 0 });
+            for (auto r : damage)
+            {
+                r.trimby({ dot_00, size });
+                if (!r) continue;
+                auto head = spans.begin() + r.coor.y;
+                auto tail = head + r.size.y;
+                while (head != tail)
+                {
+                    auto& span = *head++;
+                    span.x = std::min(span.x, r.coor.x);
+                    span.y = std::max(span.y, r.coor.x + r.size.x);
+                }
+            }
+        }
         struct bitmap_dtvt_t
             : public stream
         {
@@ -1097,8 +1407,11 @@ namespace netxs::directvt
 
             cell                           state; // bitmap: .
             core                           image; // bitmap: .
+            std::vector<twod>              spans; // bitmap: Damaged span of each row.
+            std::vector<twod>              edits; // bitmap: Changed runs of the image (x: offset, y: length).
             ui16                           last_int_index{}; // bitmap: The last received image index (hot index, we do not check indexes twice in a row).
             ui16                           last_ext_index{}; // bitmap: The last received image index (hot index, we do not check indexes twice in a row).
+            bool                           runs{}; // bitmap: Emit image runs (subtype::seq). Only for consumers that have negotiated feature::runs.
 
             enum : byte
             {
@@ -1115,11 +1428,12 @@ namespace netxs::directvt
             {
                 static constexpr auto nop = byte{ 0x00 }; // Apply current brush. nop = dif - refer.
                 static constexpr auto dif = byte{ dmax }; // Cell dif.
+                static constexpr auto seq = byte{ 0xFD }; // Apply current brush ui32 times advancing its image fragment column by one for each cell. sz_t: N.
                 static constexpr auto mov = byte{ 0xFE }; // Set insertion point. sz_t: offset.
                 static constexpr auto rep = byte{ 0xFF }; // Repeat current brush ui32 times. sz_t: N.
             };
 
-            void set(id_t winid, twod coord, core& cache, flag& abort, sz_t& delta)
+            void set(id_t winid, twod coord, core const& cache, regs const& damage, flag& abort, sz_t& delta)
             {
                 //todo multiple windows
                 stream::reinit(winid, rect{ coord, cache.size() }, binary::process_id);
@@ -1140,6 +1454,20 @@ namespace netxs::directvt
                 auto mid = src + csz.x * min.y;
                 bool bad = true;
                 auto sum = sz_t{ 0 };
+                auto run = sz_t{ 0 };
+                auto seq = [&]
+                {
+                    add(subtype::seq, run);
+                    run = 0;
+                };
+                auto adv = [](cell const& c1, cell const& c2) // Return true if c1 is c2 with the image fragment column advanced by one (image run along x).
+                {
+                    return c2.p2 && c1.p2 == c2.p2
+                        && c1.px == c2.px + 1 && (ui16)c2.px != (ui16)-1
+                        && c1.uv == c2.uv
+                        && c1.st == c2.st
+                        && c1.gc == c2.gc;
+                };
                 auto rep = [&]
                 {
                     if (sum < sizeof(subtype::rep) + sizeof(sum))
@@ -1176,49 +1504,105 @@ namespace netxs::directvt
                     if (changes & bgclr) add(cache.bgc());
                     if (changes & fgclr) add(cache.fgc());
                     if (changes & style) add(cache.stl());
-                    if (changes & rastr) add(cache.img()); //todo optimize monotonic runs along x: 1, 2, 3, ..., w
+                    if (changes & rastr) add(cache.img());
                     if (changes & glyph) add(cluster, cache.egc().bytes(), cluster);
                     state = cache;
                 };
+                auto put = [&](auto const& cache, auto const& front)
+                {
+                    if (bad)
+                    {
+                        if (sum) rep();
+                        if (run) seq();
+                        auto offset = (sz_t)(src - beg);
+                        add(subtype::mov, offset);
+                        bad = faux;
+                    }
+                    if (cache == state)
+                    {
+                        if (run) seq();
+                        ++sum;
+                    }
+                    else if (runs && adv(cache, state))
+                    {
+                        if (sum) rep();
+                        state = cache;
+                        ++run;
+                    }
+                    else
+                    {
+                        if (sum) rep();
+                        if (run) seq();
+                        auto [s_meaning, s_changes, s_cluster] = tax(cache, state);
+                        auto [f_meaning, f_changes, f_cluster] = tax(cache, front);
+                        if (s_meaning < f_meaning) dif(s_changes,         s_cluster, cache);
+                        else                       dif(f_changes | refer, f_cluster, cache);
+                    }
+                };
                 auto map = [&](auto const& cache, auto const& front)
                 {
-                    if (cache != front)
+                    if (cache != front) put(cache, front);
+                    else                bad = true;
+                };
+                auto scan = [&](auto stop)
+                {
+                    auto skip = src != stop ? cell::equal_run(&*src, &*dst, stop - src) : 0;
+                    while (true) // Alternate clean and dirty spans of the row.
                     {
-                        if (bad)
+                        if (skip)
                         {
-                            if (sum) rep();
-                            auto offset = (sz_t)(src - beg);
-                            add(subtype::mov, offset);
-                            bad = faux;
-                        }
-                        if (cache == state) ++sum;
-                        else
-                        {
-                            if (sum) rep();
-                            auto [s_meaning, s_changes, s_cluster] = tax(cache, state);
-                            auto [f_meaning, f_changes, f_cluster] = tax(cache, front);
-                            if (s_meaning < f_meaning) dif(s_changes,         s_cluster, cache);
-                            else                       dif(f_changes | refer, f_cluster, cache);
+                            src += skip;
+                            dst += skip;
+                            bad = true;
                         }
+                        if (src == stop) break;
+                        auto from = src;
+                        do put(*src++, *dst++); // The first cell of the dirty span is known to differ.
+                        while (src != stop && *src != *dst);
+                        edits.push_back({ (si32)(from - cache.begin()), (si32)(src - from) });
+                        if (src == stop) break;
+                        skip = 1 + cell::equal_run(&*src + 1, &*dst + 1, stop - src - 1); // The first cell of the clean span is known to match.
                     }
-                    else bad = true;
                 };
-                while (src != mid && !abort)
-                {
-                    auto stop = src + min.x;
-                    while (src != stop) map(*src++, *dst++);
-                    if (dtx >= 0) dst += dtx;
-                    else
+                auto same = fsz == csz;
+                edits.clear();
+                if (same) // Visit the damaged spans only.
+                {
+                    auto head = src;
+                    auto prev = dst;
+                    binary::rowspans(damage, csz, spans);
+                    for (auto y = 0; y < csz.y && !abort; y++)
                     {
-                        stop += -dtx;
-                        while (src != stop) map(*src++, pen);
+                        auto [from, upto] = spans[y];
+                        if (from < upto)
+                        {
+                            auto line = y * csz.x;
+                            src = head + line + from;
+                            dst = prev + line + from;
+                            bad = true;
+                            scan(head + line + upto);
+                        }
                     }
                 }
-                if (csz.y > fsz.y)
+                else
                 {
-                    while (src != end && !abort) map(*src++, pen);
+                    while (src != mid && !abort)
+                    {
+                        scan(src + min.x);
+                        if (dtx >= 0) dst += dtx;
+                        else
+                        {
+                            auto stop = src + -dtx;
+                            while (src != stop) map(*src++, pen);
+                        }
+                    }
+                    if (csz.y > fsz.y)
+                    {
+                        while (src != end && !abort) map(*src++, pen);
+                    }
                 }
                 if (sum) rep();
+                if (run) seq();
                 if (abort)
                 {
                     std::swap(state, pen);
@@ -1226,9 +1610,17 @@ namespace netxs::directvt
                 }
                 else
                 {
-                    auto discard_empty = fsz == csz;
-                    std::swap(image, cache);
-                    sum = commit(discard_empty);
+                    if (same) // Update the changed runs only.
+                    {
+                        auto head = cache.begin();
+                        auto prev = image.begin();
+                        for (auto [offset, length] : edits)
+                        {
+                            std::copy(head + offset, head + offset + length, prev + offset);
+                        }
+                    }
+                    else image = cache;
+                    sum = commit(same);
                 }
                 delta = sum;
             }
@@ -1288,6 +1680,7 @@ namespace netxs::directvt
                 //auto frame_len = data.size();
                 //auto nop_count = 0;
                 //auto rep_count = 0;
+                //auto seq_count = 0;
                 //auto mov_count = 0;
                 //auto dif_count = 0;
                 while (data.size() > 0)
@@ -1318,6 +1711,23 @@ namespace netxs::directvt
                         std::fill(iter, upto, mark);
                         iter = upto;
                     }
+                    else if (what == subtype::seq)
+                    {
+                        //seq_count++;
+                        auto [count] = stream::take<sz_t>(data);
+                        auto upto = iter + count;
+                        if (upto > tail)
+                        {
+                            log(prompt::dtvt, "bitmap: ", "Corrupted data, subtype: ", what);
+                            break;
+                        }
+                        auto [col, row] = mark.get_image_cr();
+                        while (iter != upto)
+                        {
+                            mark.set_image_cr(++col, row);
+                            *iter++ = mark;
+                        }
+                    }
                     else if (what == subtype::mov)
                     {
                         //mov_count++;
@@ -1366,16 +1776,18 @@ namespace netxs::directvt
 
             cell state; // bitmap_a: .
             core image; // bitmap_a: .
+            std::vector<twod> spans; // bitmap_a: Damaged span of each row.
 
             bitmap_a()
                 : stream{ Kind }
             { }
 
-            void set(id_t /*winid*/, twod /*winxy*/, core& cache, flag& abort, sz_t& delta)
+            void set(id_t /*winid*/, twod /*winxy*/, core const& cache, regs const& damage, flag& abort, sz_t& delta)
             {
                 auto coord = dot_00;
                 auto saved = state;
                 auto field = cache.size();
+                auto fresh = image.hash() != cache.hash(); // The cache has been resized.
                 auto print = [&](cell const& cache, view cluster)
                 {
                     if (cache.cur())
@@ -1411,7 +1823,7 @@ namespace netxs::directvt
                     utf::reverse_clusters(cluster, stream::block);
                 };
                 auto src = cache.begin();
-                if (image.hash() != cache.hash()) // The cache has been resized.
+                if (fresh)
                 {
                     stream::block.basevt::scroll_wipe();
                     while (coord.y < field.y)
@@ -1517,6 +1929,7 @@ namespace netxs::directvt
                     auto bad_cells = 0; // Possibly corrupted cell count.
                     coord = dot_mx;
                     auto coord_y = 0;
+                    binary::rowspans(damage, field, spans);
                     while (coord_y < field.y)
                     {
                         if (abort) // The cache size has suddenly changed.
@@ -1525,6 +1938,13 @@ namespace netxs::directvt
                             state = saved;
                             break;
                         }
+                        if (!bad_cells && spans[coord_y].x >= spans[coord_y].y) // Skip undamaged rows.
+                        {
+                            src += field.x;
+                            dst += field.x;
+                            ++coord_y;
+                            continue;
+                        }
                         auto beg = src + 1;
                         auto end = src + field.x;
                         while (src != end)
@@ -1631,7 +2051,8 @@ namespace netxs::directvt
                         ++coord_y;
                     }
                 }
-                std::swap(image, cache);
+                if (fresh || abort) image = cache;
+                else                image.copy(cache, damage);
                 delta = commit(true);
             }
             void get(view& /*data*/) { }
@@ -1645,6 +2066,7 @@ namespace netxs::directvt
             cell state; // bitmap_2: .
             core image; // bitmap_2: .
             escx defer; // bitmap_2: Complex cluster buffer (printed at the end over a filled canvas).
+            std::vector<twod> spans; // bitmap_2: Damaged span of each row.
             si32 start; // bitmap_2: Beginning of the dynamic part of the complex cluster buffer.
 
             bitmap_2()
@@ -1654,12 +2076,13 @@ namespace netxs::directvt
                 start = (si32)defer.length();
             }
 
-            void set(id_t /*winid*/, twod /*winxy*/, core& cache, flag& abort, sz_t& delta)
+            void set(id_t /*winid*/, twod /*winxy*/, core const& cache, regs const& damage, flag& abort, sz_t& delta)
             {
                 auto coord = dot_00;
                 auto coord_defer = dot_mx;
                 auto saved = state;
                 auto field = cache.size();
+                auto fresh = image.hash() != cache.hash(); // The cache has been resized.
                 auto print = [&](cell const& c, view cluster)
                 {
                     c.scan_attr<Mode>(state, stream::block);
@@ -1675,7 +2098,7 @@ namespace netxs::directvt
                     }
                 };
                 auto src = cache.begin();
-                if (image.hash() != cache.hash()) // The cache has been resized.
+                if (fresh)
                 {
                     stream::block.locate(coord);
                     while (coord.y < field.y)
@@ -1799,6 +2222,7 @@ namespace netxs::directvt
                     auto dst = image.begin();
                     coord = dot_mx;
                     auto coord_y = 0;
+                    binary::rowspans(damage, field, spans);
                     while (coord_y < field.y)
                     {
                         if (abort) // The cache size has suddenly changed.
@@ -1807,6 +2231,13 @@ namespace netxs::directvt
                             state = saved;
                             break;
                         }
+                        if (spans[coord_y].x >= spans[coord_y].y) // Skip undamaged rows.
+                        {
+                            src += field.x;
+                            dst += field.x;
+                            ++coord_y;
+                            continue;
+                        }
                         auto beg = src + 1;
                         auto end = src + field.x;
                         while (src != end)
@@ -1903,7 +2334,8 @@ namespace netxs::directvt
                         defer.resize(start);
                     }
                 }
-                std::swap(image, cache);
+                if (fresh || abort) image = cache;
+                else                image.copy(cache, damage);
                 delta = commit(true);
             }
             void get(view& /*data*/) { }
@@ -1980,7 +2412,9 @@ namespace netxs::directvt
             X(request_img       ) /* Request unknown images metadata.              */\
             X(unknown_img       ) /* Unknown image index.                          */\
             X(update_img_request) /* Unknown image index.                          */\
-            X(remove_img_request) /* Unknown image index.                          */
+            X(remove_img_request) /* Unknown image index.                          */\
+            X(features          ) /* Protocol extensions negotiation.              */\
+            X(rasterstat        ) /* GUI rasterization stats.                      */
             //X(quit             ) /* Close and disconnect dtvt app.                */
             //X(focus            ) /* Request to set focus.                         */
 
@@ -1995,7 +2429,12 @@ namespace netxs::directvt
             object_list
             #undef X
 
-            std::unordered_map<type, std::function<void(view&)>> exec; // s11n: .
+            using hndl = void(*)(s11n&, void*, view&);
+
+            std::array<hndl, 1 << (sizeof(type) * 8)> exec{}; // s11n: Frame handlers indexed by frame type.
+            void* owner{}; // s11n: Handler owner (boss).
+            binary::packed_t  packed; // s11n: Compressed frames container.
+            binary::unpacker  inflow; // s11n: Incoming stream decompressor.
             escx s11n_output; // s11n: Logs buffer.
             escx s11n_logpad; // s11n: Logs left margin.
             std::array<ui16, 65536> nat{}; // s11n: ext_to_int_map: Registered image indexes lookup map. nat[0] indicates local(0)/remote(1)
@@ -2007,12 +2446,28 @@ namespace netxs::directvt
                 auto lock = frames.sync(data);
                 for(auto& frame : lock.thing)
                 {
-                    auto iter = exec.find(frame.next);
-                    if (iter != exec.end())
-                    {
-                        iter->second(frame.data);
-                    }
-                    else log(prompt::s11n, "Unsupported frame type: ", (int)frame.next, "\n", utf::debase(frame.data));
+                    dispatch(frame.next, frame.data);
+                }
+            }
+            // s11n: Call the frame handler.
+            void dispatch(type kind, view& data)
+            {
+                if (auto proc = exec[kind])
+                {
+                    proc(*this, owner, data);
+                }
+                else log(prompt::s11n, "Unsupported frame type: ", (int)kind, "\n", utf::debase(data));
+            }
+            // s11n: Unpack the compressed frames and deserialize them.
+            void unpack(view& data)
+            {
+                packed.get(data);
+                auto block = inflow.unpack(packed.data, packed.length);
+                auto frame = binary::frame_element_t{};
+                for (auto iter = binary::frames_t::iter{ block, frame }; !iter.stop; ++iter)
+                {
+                    auto& item = *iter;
+                    if (item.next != binary::packed_t::kind) dispatch(item.next, item.data);
                 }
             }
             // s11n: Request unknown images metadata (after receiving bitmap during synchronization).
@@ -2033,15 +2488,14 @@ namespace netxs::directvt
             // s11n: Request jumbo clusters (after received bitmap synchronization).
             void request_jgc(auto& master)
             {
-                auto jumbos = cell::glyf::jumbos();
-                if (jumbos.unk.size())
+                auto unknown = cell::glyf::jumbos().unknown();
+                if (unknown.size())
                 {
                     auto list = s11n::request_gc.freeze();
-                    for (auto& token : jumbos.unk)
+                    for (auto& token : unknown)
                     {
                         list.thing.push(token);
                     }
-                    jumbos.unk.clear();
                     list.thing.sendby(master);
                 }
             }
@@ -2227,16 +2681,19 @@ namespace netxs::directvt
 
             s11n() = default;
             s11n(auto& boss, id_t boss_id = {})
+                : owner{ &boss }
             {
+                using boss_t = std::remove_reference_t<decltype(boss)>;
                 #define X(_object) \
                     if constexpr (requires(view data){ boss.direct(_object.freeze(), data); }) \
-                        exec[binary::_object::kind] = [&](auto& data){ boss.direct(_object.freeze(), data); }; \
+                        exec[binary::_object::kind] = [](s11n& s, void* b, view& data){ static_cast<boss_t*>(b)->direct(s._object.freeze(), data); }; \
                     else if constexpr (requires(view data){ boss.handle(_object.sync(data)); }) \
-                        exec[binary::_object::kind] = [&](auto& data){ boss.handle(_object.sync(data)); }; \
+                        exec[binary::_object::kind] = [](s11n& s, void* b, view& data){ static_cast<boss_t*>(b)->handle(s._object.sync(data)); }; \
                     else \
-                        exec[binary::_object::kind] = [&](auto& data){ _object.sync(data); }; // Notify on receiving.
+                        exec[binary::_object::kind] = [](s11n& s, void*,   view& data){ s._object.sync(data); }; // Notify on receiving.
                 object_list
                 #undef X
+                exec[binary::packed_t::kind] = [](s11n& s, void*, view& data){ s.unpack(data); };
                 auto lock = bitmap_dtvt.freeze();
                 lock.thing.image.link(boss_id);
             }
@@ -203,7 +203,26 @@ namespace netxs::events
     };
 
     using wook = wptr<fxbase>;
-    using fmap = std::unordered_map<hint, std::list<wptr<fxbase>>>; // Functor wptr-list map by event_id.
+    // events: Functor wptr-list map by event_id. Expired entries are compacted lazily.
+    struct fmap : std::unordered_map<hint, std::vector<wptr<fxbase>>>
+    {
+        ui64 bloom{}; // fmap: Bit summary of the subscribed event ids to skip lookups of missing ones.
+
+        static auto digest(hint event_key)
+        {
+            auto k = (ui64)event_key;
+            return (ui64)1 << ((k ^ (k >> 6) ^ (k >> 12) ^ (k >> 18) ^ (k >> 24) ^ (k >> 30)) & 63);
+        }
+        auto& operator [] (hint event_key)
+        {
+            bloom |= digest(event_key);
+            return unordered_map::operator[](event_key);
+        }
+        auto seek(hint event_key)
+        {
+            return bloom & digest(event_key) ? find(event_key) : end();
+        }
+    };
     using fxmap = utf::unordered_map<text, std::function<void()>>; // Class methods.
 
     // Class methods and registered instances.
@@ -234,7 +253,7 @@ namespace netxs::events
         };
 
         generics::indexer_fifo<id_t>              id_pool;
-        std::recursive_mutex                      mutex;
+        generics::gauge                           mutex; // auth: Global UI lock. Contention is only measured, the lock still serializes all UI work.
         std::unordered_map<id_t, std::reference_wrapper<ui::base>>  objects; // auth: Map of objects by object id.
         clasess_umap                              classes; // auth: Map of classes by classname.
         context_t                                 context; // auth: Default context.
@@ -303,7 +322,7 @@ namespace netxs::events
             for (auto& [event, fxlist] : reactor)
             {
                 auto refs = fxlist.size();
-                fxlist.remove_if([](auto&& a){ return a.expired(); });
+                std::erase_if(fxlist, [](auto&& a){ return a.expired(); });
                 auto size = fxlist.size();
                 lref += size;
                 ldel += refs - size;
@@ -337,10 +356,22 @@ namespace netxs::events
         auth(bool use_timer = faux);
 
         ui::base* get_target(context_t& source_ctx, view object_name);
-        // auth: .
-        void _refresh_and_copy(fmap::mapped_type& fxlist)
-        {
-            fxlist.remove_if([&](auto& f){ return f.expired() ? true : (qcopy.emplace_back(f), faux); });
+        // auth: Copy the live handlers of the event to qcopy. The list is compacted when at least half of it has expired.
+        void _refresh_and_copy(fmap& reactor, hint event_key)
+        {
+            auto iter = reactor.seek(event_key);
+            if (iter == reactor.end()) return;
+            auto& fxlist = iter->second;
+            auto stale = 0_sz;
+            for (auto& f : fxlist)
+            {
+                if (f.expired()) stale++;
+                else             qcopy.emplace_back(f);
+            }
+            if (stale && stale * 2 >= fxlist.size())
+            {
+                std::erase_if(fxlist, [](auto& f){ return f.expired(); });
+            }
         }
         // auth: .
         auto _select(si32 Tier, fmap& reactor, hint event, feed order)
@@ -351,12 +382,12 @@ namespace netxs::events
             {
                 auto itermask = events::level_mask(event);
                 auto subgroup = event;
-                _refresh_and_copy(reactor[subgroup | tiermask]);
+                _refresh_and_copy(reactor, subgroup | tiermask);
                 while (itermask > (1 << events::block)) // Skip root event block.
                 {
                     subgroup = event & itermask;
                     itermask >>= events::block;
-                    _refresh_and_copy(reactor[subgroup | tiermask]);
+                    _refresh_and_copy(reactor, subgroup | tiermask);
                 }
             }
             else if (order == feed::rev)
@@ -368,13 +399,13 @@ namespace netxs::events
                 {
                     itermask = (itermask << events::block) | mask;
                     subgroup = event & itermask;
-                    _refresh_and_copy(reactor[subgroup | tiermask]);
+                    _refresh_and_copy(reactor, subgroup | tiermask);
                 }
                 while (subgroup != event);
             }
             else
             {
-                _refresh_and_copy(reactor[event | tiermask]);
+                _refresh_and_copy(reactor, event | tiermask);
             }
             auto tail = qcopy.size();
             return std::pair{ head, tail };
@@ -442,7 +473,7 @@ namespace netxs::events
         // auth: .
         auto try_sync()
         {
-            struct try_sync_t : std::unique_lock<std::recursive_mutex>
+            struct try_sync_t : std::unique_lock<generics::gauge>
             {
                 using unique_lock::unique_lock;
                 operator bool () { return unique_lock::owns_lock(); }
@@ -772,7 +803,7 @@ namespace netxs::events
             auto event_key = event_id | indexer.tier_mask(tier_id);
             auto& r = tier_id == tier::general ? indexer.general : reactor;
             auto iter = r.find(event_key);
-            return iter != r.end() ? iter->second.size() : 0;
+            return iter != r.end() ? std::ranges::count_if(iter->second, [](auto& f){ return !f.expired(); }) : 0;
         }
         // bell: Erase all script handlers for the specified event.
         void erase_script_handlers(si32 tier_id, hint event_id)
@@ -216,6 +216,42 @@ namespace netxs::generics
         }
     };
 
+    // generics: Recursive mutex with contention accounting (instrumentation for the global UI lock, it does not change the locking model).
+    struct gauge
+    {
+        static constexpr auto bins = 7; // gauge: Wait time histogram bins: <1us, <10us, <100us, <1ms, <10ms, <100ms, >=100ms.
+
+        std::recursive_mutex              mutex;
+        std::atomic<ui64>                 taken{}; // gauge: Number of acquisitions.
+        std::atomic<ui64>                 waits{}; // gauge: Number of contended acquisitions.
+        std::atomic<ui64>                 spent{}; // gauge: Total wait time in nanoseconds.
+        std::array<std::atomic<ui64>, bins> hist{}; // gauge: Wait time histogram.
+
+        void lock()
+        {
+            taken.fetch_add(1, std::memory_order_relaxed);
+            if (mutex.try_lock()) return;
+            auto start = datetime::now();
+            mutex.lock();
+            auto delta = (ui64)std::chrono::duration_cast<std::chrono::nanoseconds>(datetime::now() - start).count();
+            auto index = 0;
+            for (auto limit = 1000ull; index < bins - 1 && delta >= limit; limit *= 10) index++;
+            waits.fetch_add(1, std::memory_order_relaxed);
+            spent.fetch_add(delta, std::memory_order_relaxed);
+            hist[index].fetch_add(1, std::memory_order_relaxed);
+        }
+        bool try_lock()
+        {
+            auto ok = mutex.try_lock();
+            if (ok) taken.fetch_add(1, std::memory_order_relaxed);
+            return ok;
+        }
+        void unlock()
+        {
+            mutex.unlock();
+        }
+    };
+
     // generics: Separate thread for executing deferred tasks.
     template<class T>
     struct jobs
@@ -433,8 +469,8 @@ namespace netxs::generics
             auto  operator -- (int)                 { auto temp = iter<Ring>{ *buff, addr }; buff->dec(addr); return temp;  }
             auto& operator ++ ()                    {                                        buff->inc(addr); return *this; }
             auto& operator -- ()                    {                                        buff->dec(addr); return *this; }
-            auto& operator *  ()                    { return buff->buff[addr];                                              }
-            auto  operator -> ()                    { return buff->buff.begin() + addr;                                     }
+            auto& operator *  ()                    { buff->touch(addr); return buff->buff[addr];                           }
+            auto  operator -> ()                    { buff->touch(addr); return buff->buff.begin() + addr;                  }
             auto  operator != (iter const& m) const { return addr != m.addr;                                                }
             auto  operator == (iter const& m) const { return addr == m.addr;                                                }
             auto  operator -  (iter const& m) const { return (difference_type)buff->dst(m.addr, addr);                      }
@@ -463,6 +499,12 @@ namespace netxs::generics
 
         virtual void undock_base_front(type& /*item*/, bool /*deallocate*/) { };
         virtual void undock_base_back (type& /*item*/, bool /*deallocate*/) { };
+        virtual void access_base      (type& /*item*/) { }; // ring: Notify about item access (UseUndock only).
+
+        void touch(si32 addr) const
+        {
+            if constexpr (UseUndock) const_cast<ring*>(this)->access_base(const_cast<type&>(buff[addr]));
+        }
 
         auto  current_it()         { return iter<      ring>{ *this, cart };          }
         auto  begin()              { return iter<      ring>{ *this, head };          }
@@ -470,14 +512,15 @@ namespace netxs::generics
         auto  begin() const        { return iter<const ring>{ *this, head };          }
         auto    end() const        { return iter<const ring>{ *this, mod(tail + 1) }; }
         auto& length() const       { return size;                }
-        auto&  back()              { return buff[tail];          }
-        auto&  back() const        { return buff[tail];          }
-        auto& front()              { return buff[head];          }
-        auto& front() const        { return buff[head];          }
-        auto& current     ()       { return buff[cart];          }
-        auto& operator  * ()       { return buff[cart];          }
-        auto  operator -> ()       { return buff.begin() + cart; }
-        auto&          at (si32 i) { assert(i >= 0 && i < size); return buff[mod(head + i)]; }
+        auto&  back()              { touch(tail); return buff[tail];          }
+        auto&  back() const        { touch(tail); return buff[tail];          }
+        auto& front()              { touch(head); return buff[head];          }
+        auto& front() const        { touch(head); return buff[head];          }
+        auto& current     ()       { touch(cart); return buff[cart];          }
+        auto& operator  * ()       { touch(cart); return buff[cart];          }
+        auto  operator -> ()       { touch(cart); return buff.begin() + cart; }
+        auto&          at (si32 i) { assert(i >= 0 && i < size); auto addr = mod(head + i); touch(addr); return buff[addr]; }
+        auto&        peek (si32 i) { assert(i >= 0 && i < size); return buff[mod(head + i)]; } // ring: Item access without notification.
         auto& operator [] (si32 i) { return at(i);               }
         auto  index() const        { return dst(head, cart);     }
         void  index(si32 i)        { assert((i > 0 && i < size) || i == 0); cart = mod(head + i); }
@@ -509,7 +552,7 @@ namespace netxs::generics
         template<bool UseBack = faux>
         inline void undock_front(bool deallocate = faux)
         {
-            auto& item = front();
+            auto& item = buff[head];
             if constexpr (UseUndock)
             {
                 if constexpr (UseBack) undock_base_back (item, deallocate);
@@ -521,7 +564,7 @@ namespace netxs::generics
         }
         inline void undock_back(bool deallocate = faux)
         {
-            auto& item = back();
+            auto& item = buff[tail];
             if constexpr (UseUndock) undock_base_back(item, deallocate);
             else                     item = type{};
             if (cart == tail) dec(tail), cart = tail;
@@ -550,7 +593,7 @@ namespace netxs::generics
                 auto it_2 = it_1 + d;
                 if (full())
                 {
-                    auto& item = front();
+                    auto& item = buff[head];
                     if constexpr (UseUndock)
                     {
                         static_assert(sizeof...(args) == 0);
@@ -566,7 +609,7 @@ namespace netxs::generics
                 {
                     ++size;
                     dec(head);
-                    auto& item = front();
+                    auto& item = buff[head];
                     if constexpr (UseUndock)
                     {
                         static_assert(sizeof...(args) == 0);
@@ -588,7 +631,7 @@ namespace netxs::generics
                 auto it_2 = it_1 - d;
                 if (full())
                 {
-                    auto& item = front();
+                    auto& item = buff[head];
                     if constexpr (UseUndock)
                     {
                         static_assert(sizeof...(args) == 0);
@@ -603,7 +646,7 @@ namespace netxs::generics
                 }
                 else ++size;
                 inc(tail);
-                back() = type(std::forward<Args>(args)...);
+                buff[tail] = type(std::forward<Args>(args)...);
                 swap_block<faux>(it_1, it_2, end() - 1);
                 ++it_2;
                 return it_2;
@@ -617,7 +660,7 @@ namespace netxs::generics
             if (full()) undock_front();
             else        ++size;
             inc(tail);
-            auto& item = back();
+            auto& item = buff[tail];
             if constexpr (UseUndock)
             {
                 static_assert(sizeof...(args) == 0);
@@ -634,7 +677,7 @@ namespace netxs::generics
             if (full()) undock_back();
             else        ++size;
             dec(head);
-            auto& item = front();
+            auto& item = buff[head];
             if constexpr (UseUndock)
             {
                 static_assert(sizeof...(args) == 0);
@@ -726,7 +769,7 @@ namespace netxs::generics
                         //todo optimize for !UseUndock
                         do
                         {
-                            if constexpr (UseUndock) undock_base_front(front(), true);
+                            if constexpr (UseUndock) undock_base_front(buff[head], true);
                             inc(head);
                         }
                         while (--size != new_size);
@@ -740,7 +783,7 @@ namespace netxs::generics
                         //todo optimize for !UseUndock
                         do
                         {
-                            if constexpr (UseUndock) undock_base_back(back(), true);
+                            if constexpr (UseUndock) undock_base_back(buff[tail], true);
                             dec(tail);
                         }
                         while (--size != new_size);
@@ -752,7 +795,7 @@ namespace netxs::generics
                 auto i = size;
                 while (i--)
                 {
-                    temp.emplace_back(std::move(front()));
+                    temp.emplace_back(std::move(buff[head]));
                     inc(head);
                 }
                 temp.resize(new_size);
@@ -1249,68 +1292,132 @@ namespace netxs::generics
         }
     };
 
-    // generics: Object cache.
+    // generics: Object cache sharded by key. Lookups take a shared lock on a single shard only.
+    //           Entries are never moved, so references returned by get() stay valid until remove(). There is no eviction.
     template<class T, class Key = ui64>
     struct cache
     {
     protected:
-        using lock = std::mutex;
-        using sync = std::lock_guard<lock>;
+        using lock = std::shared_mutex;
         using depo = std::unordered_map<Key, T>;
         using uset = std::unordered_set<Key>;
 
-        lock mutex{}; // Object map mutex.
-        depo store{}; // Object map.
-        uset undef{}; // List of unknown tokens.
+        static constexpr auto shards = 16; // Power of two.
+        static constexpr auto node_size = (si64)(sizeof(typename depo::value_type) + 2 * sizeof(void*)); // Approximate map node size.
 
-        struct guard : sync
+        struct shard
         {
-            depo& map;
-            uset& unk;
+            lock mutex{}; // shard: Object map mutex.
+            depo store{}; // shard: Object map.
+            uset undef{}; // shard: List of unknown tokens.
+            si64 bytes{}; // shard: Heap memory used by objects.
+        };
 
-            guard(cache& inst)
-                : sync{ inst.mutex },
-                   map{ inst.store },
-                   unk{ inst.undef }
-            { }
+        std::array<shard, shards> slots;
+
+        struct guard
+        {
+            cache& inst;
 
+            // cache: Return the shard of the token.
+            auto& slot(Key token)
+            {
+                auto hash = (ui64)std::hash<Key>{}(token) * 0x9E37'79B9'7F4A'7C15; // Fibonacci hashing to spread the keys with sparse low bits.
+                return inst.slots[hash >> (64 - std::countr_zero((ui32)shards))];
+            }
+            // cache: Return the heap memory used by object.
+            static si64 heap(T const& object)
+            {
+                if constexpr (requires{ object.capacity(); }) return (si64)(object.capacity() * sizeof(*object.data()));
+                else                                          return 0;
+            }
             // cache: Get object.
             auto& get(Key token)
             {
-                if (auto iter = map.find(token); iter != map.end())
+                auto& s = slot(token);
                 {
-                    return iter->second;
-                }
-                else
-                {
-                    static auto empty_object = T{};
-                    unk.insert(token);
-                    return empty_object;
+                    auto sync = std::shared_lock{ s.mutex };
+                    if (auto iter = s.store.find(token); iter != s.store.end()) return iter->second;
                 }
+                static auto empty_object = T{};
+                auto sync = std::unique_lock{ s.mutex };
+                if (auto iter = s.store.find(token); iter != s.store.end()) return iter->second;
+                s.undef.insert(token);
+                return empty_object;
             }
             // cache: Set object.
             void set(Key token, auto&& object)
             {
-                map[token] = std::forward<decltype(object)>(object);
+                auto& s = slot(token);
+                auto sync = std::unique_lock{ s.mutex };
+                auto [iter, added] = s.store.try_emplace(token);
+                auto& dest = iter->second;
+                if (!added && dest == object) return; // Keep references to the same object valid.
+                s.bytes -= heap(dest);
+                dest = std::forward<decltype(object)>(object);
+                s.bytes += heap(dest);
             }
             // cache: Add object.
             void add(Key token, auto&& object)
             {
-                map.insert(std::pair{ token, std::forward<decltype(object)>(object) }); // Silently ignore if it exists.
+                auto& s = slot(token);
+                {
+                    auto sync = std::shared_lock{ s.mutex };
+                    if (s.store.contains(token)) return; // Silently ignore if it exists.
+                }
+                auto sync = std::unique_lock{ s.mutex };
+                auto [iter, added] = s.store.try_emplace(token, std::forward<decltype(object)>(object));
+                if (added) s.bytes += heap(iter->second);
             }
             // cache: Remove object.
             void remove(Key token)
             {
-                map.erase(token);
+                auto& s = slot(token);
+                auto sync = std::unique_lock{ s.mutex };
+                if (auto iter = s.store.find(token); iter != s.store.end())
+                {
+                    s.bytes -= heap(iter->second);
+                    s.store.erase(iter);
+                }
             }
             // cache: Check the object existence by token.
             auto exists(Key token)
             {
-                auto iter = map.find(token);
-                auto okay = iter != map.end();
-                if (!okay) unk.insert(token);
+                auto& s = slot(token);
+                {
+                    auto sync = std::shared_lock{ s.mutex };
+                    if (s.store.contains(token)) return true;
+                }
+                auto sync = std::unique_lock{ s.mutex };
+                auto okay = s.store.contains(token);
+                if (!okay) s.undef.insert(token);
                 return okay;
             }
+            // cache: Take the list of unknown tokens.
+            auto unknown()
+            {
+                auto list = std::vector<Key>{};
+                for (auto& s : inst.slots)
+                {
+                    auto sync = std::unique_lock{ s.mutex };
+                    list.insert(list.end(), s.undef.begin(), s.undef.end());
+                    s.undef.clear();
+                }
+                return list;
+            }
+            // cache: Return the number of objects and the memory they occupy.
+            auto usage()
+            {
+                auto count = si64{};
+                auto bytes = si64{};
+                for (auto& s : inst.slots)
+                {
+                    auto sync = std::shared_lock{ s.mutex };
+                    count += (si64)s.store.size();
+                    bytes += s.bytes;
+                }
+                return std::pair{ count, bytes + count * node_size };
+            }
         };
 
     public:
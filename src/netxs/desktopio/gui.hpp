@@ -65,6 +65,7 @@ namespace netxs::gui
         twod            wincoord{};     // cfg_t: .
         twod            gridsize{};     // cfg_t: .
         si32            cell_height{};  // cfg_t: .
+        si32            glyph_cache{};  // cfg_t: Glyph cache size limit in MiB.
         std::list<text> font_names;     // cfg_t: Font family list.
         axis_vals_t     font_axes;      // cfg_t: Array of maps<axis_4byte_tag, fp32_value>.
     };
@@ -1625,23 +1626,56 @@ namespace netxs::gui
             static constexpr auto wavyunderline = __COUNTER__ - _counter;
         };
 
-        using gmap = std::unordered_map<ui64, sprite>;
+        // glyph: Cached glyph sprite.
+        struct entry : sprite
+        {
+            si64 bytes{}; // entry: Accounted memory.
+            ui64 stamp{}; // entry: Last use tick.
 
-        std::pmr::unsynchronized_pool_resource buffer_pool; // glyph: Pool for temp buffers.
-        std::pmr::monotonic_buffer_resource    mono_buffer; // glyph: Memory block for sprites.
+            entry(auto& pool)
+                : sprite{ pool }
+            { }
+        };
+        using gmap = std::unordered_map<ui64, entry>;
+        // glyph: Glyphs rasterized for a specific cell size and AA mode.
+        struct bank
+        {
+            gmap glyphs; // bank: Glyph map.
+            si64 bytes{}; // bank: Accounted memory.
+            ui64 stamp{}; // bank: Last use tick.
+        };
+        // glyph: Cache counters.
+        struct gstat
+        {
+            si64 hits{}; // gstat: Glyphs found in cache (counted once per tick).
+            si64 misses{}; // gstat: Glyphs rasterized.
+            si64 evictions{}; // gstat: Glyphs evicted.
+        };
+
+        std::pmr::unsynchronized_pool_resource buffer_pool; // glyph: Pool for sprites and temp buffers.
         fonts&                                 fcache;      // glyph: Font cache.
         twod&                                  cellsz;      // glyph: Terminal cell size in pixels.
         bool                                   aamode;      // glyph: Enable AA.
-        gmap                                   glyphs;      // glyph: Glyph map.
+        std::unordered_map<ui64, bank>         banks;       // glyph: Glyph banks by cell size and AA mode.
+        bank*                                  atlas;       // glyph: Current glyph bank.
+        si64                                   bytes;       // glyph: Memory used by all banks.
+        si64                                   limit;       // glyph: Memory limit.
+        ui64                                   clock;       // glyph: Current tick.
+        gstat                                  stats;       // glyph: Cache counters.
         std::vector<sprite>                    cgi_glyphs;  // glyph: Synthetic glyphs.
         std::vector<sprite>                    cgi_shadow;  // glyph: Synthetic shadow.
         std::vector<utfx>                      codepoints;  // glyph: Codepoint list for shaping.
 
-        glyph(fonts& fcache, bool aamode)
+        glyph(fonts& fcache, bool aamode, si32 limit_mib)
             : fcache{ fcache },
               cellsz{ fcache.cellsize },
-              aamode{ aamode }
+              aamode{ aamode },
+              atlas{},
+              bytes{},
+              limit{ (si64)std::max(1, limit_mib) << 20 },
+              clock{ 1 }
         {
+            select();
             if (fcache)
             {
                 generate_glyphs();
@@ -1852,12 +1886,65 @@ namespace netxs::gui
                 block.coor.x += fract * 3;
             }
         }
+        // glyph: Switch to the glyph bank of the current cell size and AA mode. Other banks are kept for zooming back until evicted.
+        void select()
+        {
+            auto key = (ui64)(ui32)cellsz.y << 32 | (ui64)(ui32)cellsz.x << 1 | (ui64)aamode;
+            atlas = &banks[key];
+            atlas->stamp = clock;
+        }
+        // glyph: Advance the tick. Glyphs used during the current tick are never evicted.
+        void tick()
+        {
+            atlas->stamp = ++clock;
+        }
+        // glyph: Evict glyphs until the memory limit is met: inactive banks first, then the least recently used glyphs of the current bank.
+        void trim()
+        {
+            while (bytes > limit && banks.size() > 1)
+            {
+                auto stale = banks.end();
+                for (auto iter = banks.begin(); iter != banks.end(); ++iter)
+                {
+                    if (&iter->second != atlas && (stale == banks.end() || iter->second.stamp < stale->second.stamp)) stale = iter;
+                }
+                bytes -= stale->second.bytes;
+                stats.evictions += stale->second.glyphs.size();
+                banks.erase(stale);
+            }
+            if (bytes <= limit) return;
+            auto& glyphs = atlas->glyphs;
+            auto order = std::vector<std::pair<ui64, ui64>>{}; // Pairs: stamp, token.
+            order.reserve(glyphs.size());
+            for (auto& [token, glyph_mask] : glyphs)
+            {
+                if (glyph_mask.stamp != clock) order.emplace_back(glyph_mask.stamp, token);
+            }
+            std::sort(order.begin(), order.end());
+            auto floor = limit - limit / 4; // Evict in batches to amortize sorting.
+            for (auto [stamp, token] : order)
+            {
+                if (bytes <= floor) break;
+                auto iter = glyphs.find(token);
+                bytes -= iter->second.bytes;
+                atlas->bytes -= iter->second.bytes;
+                stats.evictions++;
+                glyphs.erase(iter);
+            }
+        }
+        // glyph: Drop all banks, e.g. when the font list changes and every rasterized glyph is stale.
+        void clear_banks()
+        {
+            for (auto& [key, bank] : banks) stats.evictions += bank.glyphs.size();
+            atlas = nullptr;
+            banks.clear();
+            bytes = 0;
+        }
         void reset()
         {
-            glyphs.clear();
             cgi_glyphs.clear();
             cgi_shadow.clear();
-            mono_buffer.release();
+            select();
             generate_glyphs();
             generate_shadow();
             reset_cached_rasters();
@@ -2772,6 +2859,49 @@ namespace netxs::gui
                 draw_glyph(canvas, shadow_raster, offset, argb{ tint::pureblack });
             }
         }
+        // glyph: Return the sprite of the cell glyph, rasterize it on first use.
+        sprite* take(cell const& c)
+        {
+            auto token = c.tkn();
+            if (c.itc()) token ^= 0xAAAA'AAAA'AAAA'AA00; // Randomize token to differentiate italics (0xb101010...0000'0000 excluding matrix metadata).
+            if (c.bld()) token ^= 0x5555'5555'5555'5500; // Randomize token to differentiate bolds (0xb010101...0000'0000 excluding matrix metadata).
+            auto& glyphs = atlas->glyphs;
+            auto iter = glyphs.find(token);
+            if (iter == glyphs.end())
+            {
+                if (c.jgc())
+                {
+                    iter = glyphs.emplace(token, buffer_pool).first;
+                }
+                else return nullptr;
+            }
+            auto& glyph_mask = iter->second;
+            if (glyph_mask.stamp != clock) // Touch once per tick so that the parallel rows only read preloaded glyphs.
+            {
+                glyph_mask.stamp = clock;
+                if (glyph_mask.type != sprite::undef) stats.hits++;
+            }
+            if (glyph_mask.type == sprite::undef)
+            {
+                if (c.jgc())
+                {
+                    rasterize(glyph_mask, c);
+                    stats.misses++;
+                    auto delta = (si64)(glyph_mask.bits.capacity() * sizeof(ui32) + sizeof(gmap::value_type)) - glyph_mask.bytes;
+                    glyph_mask.bytes += delta;
+                    atlas->bytes += delta;
+                    bytes += delta;
+                    if (bytes > limit) trim();
+                }
+                else return nullptr;
+            }
+            return &glyph_mask;
+        }
+        // glyph: Rasterize the cell glyph in advance to make draw_cell read-only with respect to the glyph cache.
+        void preload(cell const& c)
+        {
+            if (!c.hid() && c.xy() != 0) take(c);
+        }
         template<class T = noop>
         void draw_cell(auto& canvas, rect placeholder, cell const& c, T&& blink_canvas = {})
         {
@@ -2874,27 +3004,9 @@ namespace netxs::gui
                 {
                     break;
                 }
-                auto token = c.tkn();
-                if (c.itc()) token ^= 0xAAAA'AAAA'AAAA'AA00; // Randomize token to differentiate italics (0xb101010...0000'0000 excluding matrix metadata).
-                if (c.bld()) token ^= 0x5555'5555'5555'5500; // Randomize token to differentiate bolds (0xb010101...0000'0000 excluding matrix metadata).
-                auto iter = glyphs.find(token);
-                if (iter == glyphs.end())
-                {
-                    if (c.jgc())
-                    {
-                        iter = glyphs.emplace(token, mono_buffer).first;
-                    }
-                    else break;
-                }
-                auto& glyph_mask = iter->second;
-                if (glyph_mask.type == sprite::undef)
-                {
-                    if (c.jgc())
-                    {
-                        rasterize(glyph_mask, c);
-                    }
-                    else break;
-                }
+                auto glyph_ptr = take(c);
+                if (!glyph_ptr) break;
+                auto& glyph_mask = *glyph_ptr;
                 if (glyph_mask.area)
                 {
                     auto [w, h, x, y] = c.whxy();
@@ -2967,6 +3079,7 @@ namespace netxs::gui
         static constexpr auto classname = basename::gui_window;
         static constexpr auto shadow_dent = dent{ dot_11 } * 3;
         static constexpr auto wheel_delta_base = 120; // WHEEL_DELTA
+        static constexpr auto raster_split = 4096; // Minimal cell count to rasterize in parallel.
 
         struct blink
         {
@@ -2976,6 +3089,80 @@ namespace netxs::gui
             byts mask{}; // blink: Blinking cells map.
             si32 poll{}; // blink: Blinking cells count.
         };
+        struct rstat
+        {
+            std::atomic<si64> spent{}; // rstat: Rasterization time of the current frame (ns).
+            span total{}; // rstat: Rasterization time since the last report.
+            span worst{}; // rstat: Longest frame rasterization since the last report.
+            si32 count{}; // rstat: Frames since the last report.
+            time stamp{}; // rstat: Last report time.
+            bool share{}; // rstat: Report to the gate (negotiated feature::rstat).
+        };
+        struct rpool // Row rasterization workers. The caller takes part in the work and returns when all rows are done.
+        {
+            using func = std::function<void(si32)>;
+
+            std::mutex               mutex; // rpool: Batch state mutex.
+            std::condition_variable  synch; // rpool: Wake up the workers.
+            std::condition_variable  drain; // rpool: Wake up the caller.
+            std::vector<std::thread> agents; // rpool: Worker threads (started on first use).
+            std::atomic<si32>        next{}; // rpool: Next row to take.
+            func                     job{}; // rpool: Row rasterizer of the current batch.
+            si32                     rows{}; // rpool: Row count of the current batch.
+            si32                     busy{}; // rpool: Workers that are still inside the current batch.
+            ui64                     epoch{}; // rpool: Batch number.
+            bool                     alive{ true }; // rpool: Workers are running.
+
+            void take()
+            {
+                auto i = 0;
+                while ((i = next++) < rows) job(i);
+            }
+            void worker()
+            {
+                auto guard = std::unique_lock{ mutex };
+                auto seen = epoch;
+                while (true)
+                {
+                    synch.wait(guard, [&]{ return !alive || epoch != seen; });
+                    if (!alive) break;
+                    seen = epoch;
+                    if (!job) continue; // The batch is already done.
+                    busy++;
+                    guard.unlock();
+                    take();
+                    guard.lock();
+                    if (--busy == 0) drain.notify_one();
+                }
+            }
+            void run(si32 count, func proc)
+            {
+                if (agents.empty())
+                {
+                    auto n = std::max(1u, std::thread::hardware_concurrency()) - 1;
+                    while (n--) agents.emplace_back(&rpool::worker, this);
+                }
+                auto guard = std::unique_lock{ mutex };
+                job = std::move(proc);
+                rows = count;
+                next = 0;
+                epoch++;
+                synch.notify_all();
+                guard.unlock();
+                take();
+                guard.lock();
+                drain.wait(guard, [&]{ return busy == 0; });
+                job = {}; // Late workers skip the finished batch.
+            }
+           ~rpool()
+            {
+                auto guard = std::unique_lock{ mutex };
+                alive = faux;
+                synch.notify_all();
+                guard.unlock();
+                for (auto& agent : agents) agent.join();
+            }
+        };
         struct bttn
         {
             static constexpr auto left     = 1 << 0;
@@ -3249,6 +3436,10 @@ namespace netxs::gui
                 s11n::receive_jgc(lock);
                 netxs::set_flag<task::all>(owner.reload); // Trigger to redraw all to update jumbo clusters.
             }
+            void handle(s11n::xs::features         lock)
+            {
+                owner.rstats.share = !!(lock.thing.flags & directvt::binary::feature::rstat); // The gate has accepted the rasterization stats.
+            }
             void handle(s11n::xs::header_request   lock)
             {
                 auto& item = lock.thing;
@@ -3454,6 +3645,8 @@ namespace netxs::gui
         fonts fcache; // winbase: Font cache.
         glyph gcache; // winbase: Glyph cache.
         blink blinks; // winbase: Blinking layer state.
+        rstat rstats; // winbase: Rasterization time stats.
+        rpool painters; // winbase: Worker pool for parallel rasterization.
         twod& cellsz; // winbase: Cell size in pixels.
         si32  origsz; // winbase: Original cell size in pixels.
         fp32  height; // winbase: Cell height in fp32 pixels.
@@ -3502,7 +3695,7 @@ namespace netxs::gui
               titles{ *this, "", "", faux },
               wfocus{ *this, ui::pro::focus::mode::relay },
               fcache{ config.font_names, config.font_axes, config.cell_height },//, [&]{ netxs::set_flag<task::all>(reload); window_post_command(ipc::no_command); } },
-              gcache{ fcache, config.antialiasing },
+              gcache{ fcache, config.antialiasing, config.glyph_cache },
               blinks{ .init = config.blink_rate },
               cellsz{ fcache.cellsize },
               origsz{ fcache.cellsize.y },
@@ -3730,6 +3923,7 @@ namespace netxs::gui
         {
             log("%%Font list changed: ", prompt::gui, flist);
             fcache.set_fonts(flist, faux);
+            gcache.clear_banks();
             change_cell_size(true);
         }
         auto move_window(twod delta)
@@ -4088,12 +4282,21 @@ namespace netxs::gui
         // Note: Always do sync_blinky_mask() before calling fill_stripe.
         void fill_stripe(auto head, auto tail, twod start = {}, si32 offset = {})
         {
+            auto stamp = datetime::now();
+            gcache.tick();
             auto prime_canvas = layer_get_bits(master);
             auto blink_canvas = layer_get_bits(blinky);
             auto origin = blink_canvas.coor();
             auto iter = blinks.mask.begin() + offset;
             auto p = rect{ origin + start, cellsz };
             auto m = origin + blink_canvas.size();
+            auto draw = [&](auto& prime_canvas, auto& blink_canvas, cell const& c, rect p)
+            {
+                if (c.cur()) draw_cell_with_cursor(prime_canvas, p, c, blink_canvas);
+                else         gcache.draw_cell(prime_canvas, p, c, blink_canvas);
+            };
+            auto split = tail - head >= raster_split && std::thread::hardware_concurrency() > 1; // Rasterize large updates by rows in parallel.
+            auto rows = std::vector<std::tuple<decltype(head), rect, si32>>{}; // Row runs: first cell, its placeholder, cell count.
             while (head != tail)
             {
                 auto& c = *head++;
@@ -4109,8 +4312,13 @@ namespace netxs::gui
                     }
                 }
                 if (b) blinky.strike(p);
-                if (c.cur()) draw_cell_with_cursor(prime_canvas, p, c, blink_canvas);
-                else         gcache.draw_cell(prime_canvas, p, c, blink_canvas);
+                if (!split || c.get_image_index()) draw(prime_canvas, blink_canvas, c, p); // Images are rasterized on demand and are not shared between threads.
+                else
+                {
+                    gcache.preload(c);
+                    if (rows.empty() || p.coor.x == origin.x) rows.emplace_back(head - 1, p, 0);
+                    std::get<2>(rows.back()) = (si32)(head - std::get<0>(rows.back()));
+                }
                 p.coor.x += cellsz.x;
                 if (p.coor.x >= m.x)
                 {
@@ -4119,6 +4327,29 @@ namespace netxs::gui
                     if (p.coor.y >= m.y) break;
                 }
             }
+            if (rows.size())
+            {
+                auto strip = [&](bits& canvas, si32 y) // Take the canvas rows of the cell row only, so that the decorations that overhang the cell (underlines, wide glyphs) cannot reach the pixels of the rows rasterized by other threads.
+                {
+                    auto& area = canvas.area();
+                    auto top = std::clamp(y - area.coor.y, 0, area.size.y);
+                    auto height = std::min(cellsz.y, area.size.y - top);
+                    return bits{ std::span{ canvas.begin() + top * area.size.x, (size_t)(height * area.size.x) }, rect{{ area.coor.x, area.coor.y + top }, { area.size.x, height }}};
+                };
+                painters.run((si32)rows.size(), [&](si32 i)
+                {
+                    auto [c, p, n] = rows[i];
+                    auto prime = strip(prime_canvas, p.coor.y);
+                    auto blink = strip(blink_canvas, p.coor.y);
+                    while (n--)
+                    {
+                        if (!c->get_image_index()) draw(prime, blink, *c, p);
+                        ++c;
+                        p.coor.x += cellsz.x;
+                    }
+                });
+            }
+            rstats.spent += datetime::round<si64, std::chrono::nanoseconds>(datetime::now() - stamp);
         }
         void draw_grid(layer& s, auto& facedata, bool apply_contour = true) //todo just output ui::core
         {
@@ -4164,20 +4395,37 @@ namespace netxs::gui
             auto head = bitmap.begin();
             auto iter = head;
             auto tail = bitmap.end();
+            auto last = ui16{}; // The predicate depends on the image index only, so it is not checked twice in a row for the same index.
+            auto used = pred(last);
+            auto test = [&](cell const& c)
+            {
+                auto image_index = c.get_image_index();
+                if (image_index != last)
+                {
+                    last = image_index;
+                    used = pred(image_index);
+                }
+                return used;
+            };
             sync_blinky_mask();
             while (iter != tail) // Scan the bitmap_dtvt grid and mark all dirty regions.
             {
-                auto& c = *iter;
-                if (pred(c)) //todo optimize repeats
+                if (test(*iter))
                 {
                     auto offset = (si32)(iter - head);
-                    auto origin = twod{ offset % gridsz.x, offset / gridsz.x } * cellsz;
-                    fill_stripe(iter, iter + 1, origin, offset);
-                    auto dirty = rect{ origin + blinky.area.coor, cellsz };
+                    auto column = offset % gridsz.x;
+                    auto stop = iter + std::min(gridsz.x - column, (si32)(tail - iter)); // Merge the dirty cells of the row into a single run.
+                    auto from = iter;
+                    while (++iter != stop && test(*iter))
+                    { }
+                    auto count = (si32)(iter - from);
+                    auto origin = twod{ column, offset / gridsz.x } * cellsz;
+                    fill_stripe(from, iter, origin, offset);
+                    auto dirty = rect{ origin + blinky.area.coor, { cellsz.x * count, cellsz.y }};
                     master.strike(dirty);
                     hit = true;
                 }
-                ++iter;
+                else ++iter;
             }
             return hit;
         }
@@ -4211,9 +4459,8 @@ namespace netxs::gui
         bool update_touched_images(std::bitset<65536> const& touched_images)
         {
             auto images = cell::images(); // Lock.
-            auto hit = _update_master_bitmap([&](cell& c)
+            auto hit = _update_master_bitmap([&](ui16 image_index)
             {
-                auto image_index = c.get_image_index();
                 return touched_images[image_index] || hit_layers(images, image_index, [&](auto& layer){ return touched_images[layer.index]; });
             });
             return hit;
@@ -4221,13 +4468,35 @@ namespace netxs::gui
         bool update_image_bits(ui16 updated_image_index)
         {
             auto images = cell::images(); // Lock.
-            auto hit = _update_master_bitmap([&](cell& c)
+            auto hit = _update_master_bitmap([&](ui16 image_index)
             {
-                auto image_index = c.get_image_index();
                 return image_index == updated_image_index || hit_layers(images, image_index, [&](auto& layer){ return layer.index == updated_image_index; });
             });
             return hit;
         }
+        void raster_report() // Send the rasterization time per frame and the glyph cache counters to the gate once a second (shown in the debug overlay).
+        {
+            auto spent = span{ std::chrono::nanoseconds{ rstats.spent.exchange(0) }};
+            if (spent == span::zero()) return;
+            auto now = datetime::now();
+            rstats.total += spent;
+            rstats.worst = std::max(rstats.worst, spent);
+            rstats.count++;
+            if (now - rstats.stamp > 1s)
+            {
+                if (rstats.share)
+                {
+                    auto average = datetime::round<si64, std::chrono::microseconds>(rstats.total) / rstats.count;
+                    auto longest = datetime::round<si64, std::chrono::microseconds>(rstats.worst);
+                    stream.rasterstat.send(stream.intio, rstats.count, average, longest, gcache.bytes, (si32)gcache.banks.size(), gcache.stats.hits, gcache.stats.misses, gcache.stats.evictions);
+                }
+                gcache.stats = {};
+                rstats.total = {};
+                rstats.worst = {};
+                rstats.count = 0;
+                rstats.stamp = now;
+            }
+        }
         void update_gui()
         {
             if (!reload || waitsz) return;
@@ -4279,6 +4548,7 @@ namespace netxs::gui
                 {
                     layer_present(l);
                 }
+                raster_report();
             }
             isbusy.exchange(faux);
         }
@@ -5067,6 +5337,7 @@ namespace netxs::gui
                 };
                 base::broadcast(tier::anycast, e2::form::upon::started, This());
             }
+            stream.features.send(stream.intio, directvt::binary::feature::runs | directvt::binary::feature::rstat); // The gate keeps sending the plain bitmap records if it does not know the frame.
             auto winio = std::thread{ [&]
             {
                 auto sync = [&](view data)
@@ -33,6 +33,7 @@
 #include <random>
 #include <ranges>  // std::views::reverse
 #include <regex>
+#include <shared_mutex>
 #include <span>
 #include <sstream>
 #include <string>
@@ -75,6 +76,25 @@
     #define faux (false)
 #endif
 
+#if defined(__AVX2__)
+    #define VTM_SIMD_AVX2
+    #include <immintrin.h> // AVX2 intrinsics.
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define VTM_SIMD_SSE2
+    #include <emmintrin.h> // SSE2 intrinsics.
+#endif
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_AMD64) || defined(_M_IX86)
+    #define VTM_SIMD_DISPATCH // AVX2 kernels are selected at runtime.
+    #include <immintrin.h>
+    #if defined(__GNUC__) || defined(__clang__)
+        #define VTM_TARGET_AVX2 __attribute__((target("avx2")))
+    #else
+        #include <intrin.h> // __cpuid, _xgetbv.
+        #define VTM_TARGET_AVX2
+    #endif
+#endif
+
 namespace netxs
 {
     using int8 = int8_t;
@@ -134,6 +154,30 @@ namespace netxs
         = faux; // SSH could crash if true.
         #endif
 
+    // intmath: Return true if the CPU and OS support AVX2 (checked once).
+    static auto cpu_avx2()
+    {
+        static const auto avx2 = []
+        {
+            #if defined(__AVX2__)
+                return true;
+            #elif defined(VTM_SIMD_DISPATCH) && (defined(__GNUC__) || defined(__clang__))
+                return !!__builtin_cpu_supports("avx2");
+            #elif defined(VTM_SIMD_DISPATCH)
+                int regs[4];
+                __cpuid(regs, 0);
+                if (regs[0] < 7) return faux;
+                __cpuid(regs, 1);
+                auto osxsave = (regs[2] & (1 << 27)) && (_xgetbv(0) & 6) == 6; // The OS saves YMM registers.
+                __cpuidex(regs, 7, 0);
+                return osxsave && (regs[1] & (1 << 5));
+            #else
+                return faux;
+            #endif
+        }();
+        return avx2;
+    }
+
     [[maybe_unused]] static auto _k0 = 0; // LCtrl+Wheel.
     [[maybe_unused]] static auto _k1 = 0; // Alt+Wheel.
     [[maybe_unused]] static auto _k2 = 0; // LCtrl+Alt+Wheel.
@@ -1135,6 +1179,7 @@ namespace netxs
         }
     }
     // intmath: Draw a rectangular area inside the canvas by calling handle(canvas_element) without checking the bounds.
+    //          Row spans are passed to handle.batch(head, tail) at once if the handle supports it.
     template<bool RtoL = faux, class T, class Rect, class P, class NewlineFx = noop, bool Plain = std::is_same_v<void, std::invoke_result_t<P, decltype(*(std::declval<T&>().begin()))>>>
     void onrect(T&& canvas, Rect const& region, P handle, NewlineFx online = {})
     {
@@ -1148,17 +1193,25 @@ namespace netxs
             while (true)
             {
                 auto bound = frame + joint.size.x;
-                while (bound != frame)
+                if constexpr (!RtoL && Plain && requires{ handle.batch(&*frame, &*frame); })
                 {
-                    if constexpr (RtoL)
-                    {
-                        if constexpr (Plain) handle(*--bound);
-                        else             if (handle(*--bound)) return;
-                    }
-                    else
+                    handle.batch(&*frame, &*frame + joint.size.x);
+                    frame = bound;
+                }
+                else
+                {
+                    while (bound != frame)
                     {
-                        if constexpr (Plain) handle(*frame++);
-                        else             if (handle(*frame++)) return;
+                        if constexpr (RtoL)
+                        {
+                            if constexpr (Plain) handle(*--bound);
+                            else             if (handle(*--bound)) return;
+                        }
+                        else
+                        {
+                            if constexpr (Plain) handle(*frame++);
+                            else             if (handle(*frame++)) return;
+                        }
                     }
                 }
                 if constexpr (RtoL) frame += joint.size.x;
@@ -1615,18 +1668,16 @@ namespace netxs
                 }
                 if (small) // Sub l_val, add r_val.
                 {
-                    d_cur += d_dtx;
-                    d_end = d_cur + d_rev;
-                    while (true)
+                    for (auto n = width - w; n--;) // Both window edges are outside the line (zero steps if width == w).
                     {
+                        d_cur += d_dtx;
                         accum -= l_val;
                         accum += r_val;
                         debug(accum);
                         d_ref(d_cur) = Calc ? accum / count : accum;
                         shade(*d_cur);
-                        if (d_cur == d_end) break;
-                        d_cur += d_dtx;
                     }
+                    d_cur += d_dtx;
                     s_cur = s_ptr;
                 }
                 else // Sub src, add src.
@@ -1538,7 +1538,23 @@ namespace netxs::ui
         using type = deco::type;
         using body = std::vector<cell>;
 
+        struct fields // Changed fields mask in packed records.
+        {
+            static constexpr auto uv = byte{ 1 << 0 };
+            static constexpr auto st = byte{ 1 << 1 };
+            static constexpr auto px = byte{ 1 << 2 };
+            static constexpr auto id = byte{ 1 << 3 };
+        };
+        struct modes // Cluster mode in packed records.
+        {
+            static constexpr auto fill  = byte{ 1 << 4 };
+            static constexpr auto ascii = byte{ 1 << 5 };
+            static constexpr auto token = byte{ 1 << 6 };
+            static constexpr auto spill = byte{ 1 << 7 }; // The packed records are stored externally (see line::spill()).
+        };
+
         body cells{}; // line: Cell data.
+        text frost{}; // line: Packed cell data of the cold line (see line::freeze()).
         cell brush{}; // line: Current brush.
         id_t index{}; // line: Line index.
         wrap wraps : 2 = {}; // line: Autowrap.
@@ -1566,6 +1582,8 @@ namespace netxs::ui
 
         void reinitialize(id_t line_id, deco const& line_style, cell const& blank, si32 len = 0)
         {
+            assert(!spilled()); // The external record must be released by the storage owner first.
+            frost.clear();
             cells.assign(len, blank);
             brush = blank;
             index = line_id;
@@ -1576,6 +1594,8 @@ namespace netxs::ui
         }
         void reinitialize(id_t line_id, deco const& line_style, std::span<cell const> proto)
         {
+            assert(!spilled()); // The external record must be released by the storage owner first.
+            frost.clear();
             cells.assign(proto.begin(), proto.end());
             brush = {};
             index = line_id;
@@ -1590,6 +1610,146 @@ namespace netxs::ui
         void deallocate()
         {
             body().swap(cells);
+            text().swap(frost);
+        }
+        // line: Return true if the cells are packed.
+        auto frozen() const
+        {
+            return !frost.empty();
+        }
+        // line: Pack cells into a run-length encoded form and release the cell storage.
+        //       Record: { mode_and_changed_fields_mask, changed_fields..., payload }.
+        //       Modes: fill (n copies of the previous cluster), ascii (n single-byte clusters), token (one raw cluster token).
+        void freeze()
+        {
+            if (frozen() || image || cells.empty()) return; // Image cells are subject to sixel accounting and stay unpacked.
+            auto count = (si32)cells.size();
+            auto& dest = frost;
+            auto put = [&](auto const& field){ dest.append((char const*)&field, sizeof(field)); };
+            auto is_ascii = [](cell const& c)
+            {
+                auto b = (byte)c.gc.bytes()[1];
+                return b >= 0x20 && b < 0x7f && c.gc.token == cell::glyf{ (char)b }.token;
+            };
+            auto same_brush = [](cell const& a, cell const& b)
+            {
+                return a.uv == b.uv && a.st == b.st && a.px == b.px && a.p2 == b.p2 && a.id == b.id;
+            };
+            dest.reserve(sizeof(count) + count / 2 + 16);
+            put(count);
+            auto last = cell{};
+            auto head = cells.begin();
+            auto tail = cells.end();
+            while (head != tail)
+            {
+                auto& c = *head;
+                auto mask = byte{};
+                if (c.uv != last.uv) mask |= fields::uv;
+                if (c.st != last.st) mask |= fields::st;
+                if (c.px != last.px || c.p2 != last.p2) mask |= fields::px;
+                if (c.id != last.id) mask |= fields::id;
+                auto n = 1;
+                auto limit = (si32)std::min<ptrdiff_t>(255, tail - head);
+                if (c.gc == last.gc)
+                {
+                    while (n < limit && same_brush(head[n], c) && head[n].gc == c.gc) n++;
+                    mask |= modes::fill;
+                }
+                else if (is_ascii(c))
+                {
+                    while (n < limit && same_brush(head[n], c) && is_ascii(head[n])) n++;
+                    mask |= modes::ascii;
+                }
+                else mask |= modes::token;
+                dest.push_back((char)mask);
+                if (mask & fields::uv) put(c.uv);
+                if (mask & fields::st) put(c.st.token);
+                if (mask & fields::px) put(c.px), put(c.p2);
+                if (mask & fields::id) put(c.id);
+                if (mask & modes::token) put(c.gc.token);
+                else
+                {
+                    dest.push_back((char)n);
+                    if (mask & modes::ascii)
+                    {
+                        for (auto i = 0; i < n; i++) dest.push_back(head[i].gc.bytes()[1]);
+                    }
+                }
+                last = head[n - 1];
+                head += n;
+            }
+            dest.shrink_to_fit();
+            body().swap(cells);
+        }
+        // line: Return true if the packed records are stored externally.
+        bool spilled() const
+        {
+            return frost.size() > sizeof(si32) && (byte)frost[sizeof(si32)] == modes::spill;
+        }
+        // line: Return the packed records.
+        auto packed() const
+        {
+            return view{ frost }.substr(sizeof(si32));
+        }
+        // line: Replace the packed records with the external storage reference.
+        void spill(ui64 ref)
+        {
+            frost.resize(sizeof(si32));
+            frost.push_back((char)modes::spill);
+            frost.append((char const*)&ref, sizeof(ref));
+            frost.shrink_to_fit();
+        }
+        // line: Return the external storage reference.
+        auto spill_ref() const
+        {
+            auto ref = ui64{};
+            std::memcpy(&ref, frost.data() + sizeof(si32) + 1, sizeof(ref));
+            return ref;
+        }
+        // line: Unpack cells.
+        void thaw()
+        {
+            assert(!spilled()); // The spilled records are read from the external storage (see thaw(view)).
+            if (frozen()) thaw(packed());
+        }
+        // line: Unpack cells from the specified packed records.
+        void thaw(view data)
+        {
+            auto get = [&](auto& field){ std::memcpy((void*)&field, data.data(), sizeof(field)); data.remove_prefix(sizeof(field)); };
+            auto count = si32{};
+            std::memcpy(&count, frost.data(), sizeof(count));
+            cells.reserve(count);
+            auto c = cell{};
+            while (data.size())
+            {
+                auto mask = (byte)data.front();
+                data.remove_prefix(1);
+                if (mask & fields::uv) get(c.uv);
+                if (mask & fields::st) get(c.st.token);
+                if (mask & fields::px) get(c.px), get(c.p2);
+                if (mask & fields::id) get(c.id);
+                if (mask & modes::token)
+                {
+                    get(c.gc.token);
+                    cells.push_back(c);
+                }
+                else
+                {
+                    auto n = (byte)data.front();
+                    data.remove_prefix(1);
+                    if (mask & modes::ascii)
+                    {
+                        for (auto ch : data.substr(0, n))
+                        {
+                            c.gc = cell::glyf{ ch };
+                            cells.push_back(c);
+                        }
+                        data.remove_prefix(n);
+                    }
+                    else cells.insert(cells.end(), n, c);
+                }
+            }
+            text().swap(frost);
         }
         // line: Return default object ID for the line owner.
         auto link() const
@@ -1599,11 +1759,17 @@ namespace netxs::ui
         // line: Return true if line is empty.
         auto empty() const
         {
-            return cells.empty();
+            return cells.empty() && !frozen();
         }
         // line: Return line length.
         auto size() const
         {
+            if (frozen()) // The packed length is stored first.
+            {
+                auto count = si32{};
+                std::memcpy(&count, frost.data(), sizeof(count));
+                return count;
+            }
             return (si32)cells.size();
         }
         // line: Return line length.
@@ -2593,6 +2759,15 @@ namespace netxs::ui
         }
     };
 
+    // richtext: Source and result of the previous face::blur call (see face::blur(r, memo)).
+    struct blur_memo
+    {
+        std::vector<cell> under; // blur_memo: Cells underneath before blurring.
+        std::vector<cell> above; // blur_memo: Blurred cells.
+        si32 radius{}; // blur_memo: Blur radius.
+        si32 width{};  // blur_memo: Clip width.
+    };
+
     // richtext: Textographical canvas.
     class face
         : public rich, public flow, public std::enable_shared_from_this<face>
@@ -2931,35 +3106,76 @@ namespace netxs::ui
         template<bool InnerGlow = faux, class T = vrgb, class P = noop>
         void blur(si32 r, T&& cache = {}, P shade = {}) // face: .
         {
-            using irgb = vrgb::value_type;
-
             auto area = core::area();
             auto clip = core::clip();
 
             auto w = std::max(0, clip.size.x);
             auto h = std::max(0, clip.size.y);
-            auto s = w * h;
-
-            if (cache.size() < (size_t)s)
-            {
-                cache.resize(s);
-            }
 
             auto s_ptr = core::begin(clip.coor - area.coor);
-            auto d_ptr = cache.begin();
-
             auto s_width = area.size.x;
-            auto d_width = clip.size.x;
-
-            auto s_point = [](auto c)->auto& { return c->bgc(); };
-            auto d_point = [](auto c)->auto& { return *c;       };
 
             for (auto _(2); _--;) // Emulate Gaussian blur.
-            netxs::boxblur<irgb, InnerGlow>(s_ptr,
-                                            d_ptr, w,
-                                                   h, r, s_width,
-                                                         d_width, 2, s_point,
-                                                                     d_point, shade);
+            netxs::misc::boxblur_bgc<InnerGlow>(s_ptr, cache, w, h, r, s_width, shade);
+        }
+        // face: Double boxblur the face background, recomputing only the rows affected by the changes since the previous call.
+        template<bool InnerGlow = faux, class T = vrgb, class P = noop>
+        void blur(si32 r, blur_memo& memo, T&& cache = {}, P shade = {})
+        {
+            auto area = core::area();
+            auto clip = core::clip();
+            auto w = std::max(0, clip.size.x);
+            auto h = std::max(0, clip.size.y);
+            auto s = (size_t)w * h;
+            auto row = [&](si32 y){ return core::begin(clip.coor - area.coor + twod{ 0, y }); };
+            auto keep = [&](auto& dest, si32 from, si32 upto) // Save rows [from, upto) of the clip.
+            {
+                for (auto y = from; y < upto; y++) std::copy(row(y), row(y) + w, dest.begin() + (size_t)y * w);
+            };
+            auto load = [&](si32 from, si32 upto) // Restore blurred rows [from, upto) of the clip, keeping the current object ids.
+            {
+                for (auto y = from; y < upto; y++)
+                {
+                    auto src = memo.above.begin() + (size_t)y * w;
+                    for (auto& c : std::span{ row(y), (size_t)w })
+                    {
+                        auto id = c.link();
+                        c = *src++;
+                        c.link(id);
+                    }
+                }
+            };
+            auto same = [&](si32 y){ return cell::equal_run(&*row(y), memo.under.data() + (size_t)y * w, w) == (size_t)w; };
+            if (memo.under.size() != s || memo.radius != r || memo.width != w)
+            {
+                memo.radius = r;
+                memo.width = w;
+                memo.under.resize(s);
+                memo.above.resize(s);
+                keep(memo.under, 0, h);
+                blur<InnerGlow>(r, cache, shade);
+                keep(memo.above, 0, h);
+                return;
+            }
+            auto head = 0;
+            auto tail = h;
+            while (head < tail && same(head)) head++;
+            while (tail > head && same(tail - 1)) tail--;
+            if (head != tail)
+            {
+                keep(memo.under, head, tail);
+                auto reach = 2 * r; // Each of the two passes spreads the change by r rows.
+                head = std::max(0, head - reach);
+                tail = std::min(h, tail + reach);
+                auto from = std::max(0, head - reach); // Blur with enough context to hide the boundary approximation.
+                auto upto = std::min(h, tail + reach);
+                core::clip({{ clip.coor.x, clip.coor.y + from }, { w, upto - from }});
+                blur<InnerGlow>(r, cache, shade);
+                core::clip(clip);
+                keep(memo.above, head, tail);
+            }
+            load(0, head);
+            load(tail, h);
         }
     };
 
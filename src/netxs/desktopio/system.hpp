@@ -47,7 +47,9 @@
     #include <syslog.h>     // syslog, daemonize
 
     #include <sys/stat.h>   // ::chmod()
+    #include <sys/mman.h>   // ::mmap()
     #include <fcntl.h>      // ::splice()
+    #include <poll.h>       // ::poll()
 
     #if __has_include(<features.h>)
         #include <features.h> // __GLIBC__
@@ -62,6 +64,8 @@
             #include <linux/input.h>// mouse button codes: BTN_LEFT ...
         #endif
         #include <linux/keyboard.h> // ::keyb_ioctl()
+        #include <sys/epoll.h>      // ::epoll_wait()
+        #include <sys/eventfd.h>    // ::eventfd()
     #endif
 
     #if defined(__APPLE__)
@@ -1696,15 +1700,9 @@ namespace netxs::os
             auto wait(span timeout = {})
             {
                 using namespace std::chrono;
-                auto s = datetime::round<decltype(::timeval::tv_sec), seconds>(timeout);
-                auto m = datetime::round<decltype(::timeval::tv_usec), microseconds>(timeout - seconds{ s });
-                auto v = ::timeval{ .tv_sec = s, .tv_usec = m };
-                auto t = timeout != span{} ? &v : nullptr /*infinite*/;
-                auto socks = fd_set{};
-                FD_ZERO(&socks);
-                FD_SET(h[0], &socks);
-                auto nfds = 1 + h[0];
-                auto fired = ::select(nfds, &socks, 0, 0, t);
+                auto t = timeout != span{} ? datetime::round<si32, milliseconds>(timeout) : -1 /*infinite*/;
+                auto sock = ::pollfd{ .fd = h[0], .events = POLLIN, .revents = 0 };
+                auto fired = ::poll(&sock, 1, t);
                 return fired;
             }
 
@@ -1960,31 +1958,25 @@ namespace netxs::os
 
             #else
 
+                // Note: ::poll() is used instead of ::select() because fd_set is limited to FD_SETSIZE descriptor values.
                 template<class P, class ...Args>
-                auto _fd_set(fd_set& socks, fd_t handle, P&& /*proc*/, Args&&... args)
+                void _fd_set(::pollfd* socks, fd_t handle, P&& /*proc*/, Args&&... args)
                 {
-                    if (handle != os::invalid_fd) FD_SET(handle, &socks);
-                    if constexpr (sizeof...(args))
-                    {
-                        return std::max(handle, _fd_set(socks, std::forward<Args>(args)...));
-                    }
-                    else
-                    {
-                        return handle;
-                    }
+                    *socks = { .fd = handle, .events = POLLIN, .revents = 0 }; // Negative descriptors are ignored by ::poll().
+                    if constexpr (sizeof...(args)) _fd_set(++socks, std::forward<Args>(args)...);
                 }
                 template<class T, class P, class ...Args>
-                auto _select(T count, fd_set& socks, fd_t handle, P&& proc, Args&&... args)
+                auto _select(T count, ::pollfd* socks, fd_t /*handle*/, P&& proc, Args&&... args)
                 {
                     if (count > 0)
                     {
-                        if (handle != os::invalid_fd && FD_ISSET(handle, &socks))
+                        if (socks->revents & (POLLIN | POLLHUP | POLLERR))
                         {
                             proc();
                             count--;
                         }
-                        // Multiple descriptors can be ready in a single ::select() iteration.
-                        if constexpr (sizeof...(args)) _select(count, socks, std::forward<Args>(args)...);
+                        // Multiple descriptors can be ready in a single ::poll() iteration.
+                        if constexpr (sizeof...(args)) _select(count, ++socks, std::forward<Args>(args)...);
                     }
                 }
 
@@ -2026,20 +2018,17 @@ namespace netxs::os
 
             #else
 
-                auto socks = fd_set{};
-                FD_ZERO(&socks);
-                auto nfds = 1 + _fd_set(socks, std::forward<Args>(args)...);
+                auto socks = std::array<::pollfd, sizeof...(Args) / 2>{};
+                _fd_set(socks.data(), std::forward<Args>(args)...);
                 if (timeout == netxs::maxspan) // Blocking call.
                 {
-                    count = ::select(nfds, &socks, 0, 0, nullptr);
+                    count = ::poll(socks.data(), socks.size(), -1);
                 }
                 else // Use timeout.
                 {
                     auto start = datetime::now();
-                    auto ssec = datetime::round<decltype(::timeval{}.tv_sec), std::chrono::seconds>(timeout);
-                    auto usec = datetime::round<decltype(::timeval{}.tv_usec), std::chrono::microseconds>(timeout - std::chrono::seconds{ ssec });
-                    auto timeval = ::timeval{ .tv_sec = ssec, .tv_usec = usec };
-                    count = ::select(nfds, &socks, 0, 0, &timeval);
+                    auto msec = netxs::saturate_cast<si32>(std::chrono::ceil<std::chrono::milliseconds>(timeout).count()); // Round up to not wake up before the deadline.
+                    count = ::poll(socks.data(), socks.size(), msec);
                     if (count == 0) // Timeout.
                     {
                         //log("timeout dt=", datetime::now() - start);
@@ -2056,7 +2045,7 @@ namespace netxs::os
                         timeout -= std::min(timeout, datetime::now() - start);
                     }
                 }
-                _select(count, socks, std::forward<Args>(args)...);
+                _select(count, socks.data(), std::forward<Args>(args)...);
 
             #endif
         }
@@ -2088,6 +2077,189 @@ namespace netxs::os
             }
             return done;
         }
+
+        #if defined(__linux__)
+
+        // os::io: A shared epoll loop that multiplexes readable descriptors in a single thread
+        //         instead of running a blocking reading thread per descriptor.
+        struct reactor
+        {
+            struct entry
+            {
+                fd_t                  fd; // entry: Watched descriptor.
+                ui32                  events; // entry: Watched readiness (EPOLLIN or EPOLLOUT).
+                ui64                  token; // entry: Registration token.
+                flag                  alive; // entry: The descriptor is still registered.
+                flag                  held; // entry: Watching is suspended until resume().
+                std::mutex            mutex; // entry: Held while the handler is running.
+                std::function<bool()> proc; // entry: Readiness handler. Returns faux to unregister.
+                std::function<void()> done; // entry: Called in the reactor thread after proc returns faux.
+            };
+
+            std::mutex                           mutex; // reactor: Registry mutex.
+            std::unordered_map<ui64, sptr<entry>> items; // reactor: Registry.
+            std::thread                          agent; // reactor: Polling thread.
+            ui64                                 count; // reactor: Registration counter (zero is reserved for the wake up descriptor).
+            fd_t                                 efd; // reactor: epoll descriptor.
+            fd_t                                 wfd; // reactor: Wake up descriptor.
+            bool                                 quit; // reactor: Shutdown request.
+
+            static inline thread_local entry* running = nullptr; // reactor: The entry whose handler is running in the reactor thread.
+
+            reactor()
+                : count{ 0 },
+                  efd{ ::epoll_create1(EPOLL_CLOEXEC) },
+                  wfd{ ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK) },
+                  quit{ faux }
+            {
+                auto event = ::epoll_event{ .events = EPOLLIN, .data = { .u64 = 0 } };
+                ok(::epoll_ctl(efd, EPOLL_CTL_ADD, wfd, &event), "::epoll_ctl(EPOLL_CTL_ADD)", os::unexpected);
+                agent = std::thread{ [&]{ poll(); } };
+            }
+           ~reactor()
+            {
+                quit = true;
+                auto one = ui64{ 1 };
+                (void)!::write(wfd, &one, sizeof(one));
+                if (agent.joinable()) agent.join();
+                os::close(wfd);
+                os::close(efd);
+            }
+            void poll()
+            {
+                auto queue = std::array<::epoll_event, 64>{};
+                while (true)
+                {
+                    auto n = ::epoll_wait(efd, queue.data(), (si32)queue.size(), -1);
+                    if (n < 0)
+                    {
+                        if (errno == EINTR) continue;
+                        os::fail("::epoll_wait()", os::unexpected);
+                        break;
+                    }
+                    for (auto& event : std::span{ queue.data(), (size_t)n })
+                    {
+                        auto token = event.data.u64;
+                        if (token == 0)
+                        {
+                            auto data = ui64{};
+                            (void)!::read(wfd, &data, sizeof(data));
+                            if (quit) return;
+                            continue;
+                        }
+                        auto item = sptr<entry>{};
+                        {
+                            auto guard = std::lock_guard{ mutex };
+                            if (auto iter = items.find(token); iter != items.end()) item = iter->second;
+                        }
+                        if (!item) continue; // Unregistered after the event was queued.
+                        auto guard = std::lock_guard{ item->mutex };
+                        if (!item->alive || item->held) continue;
+                        running = item.get();
+                        auto next = item->proc();
+                        running = nullptr;
+                        if (next)
+                        {
+                            if (item->held) ::epoll_ctl(efd, EPOLL_CTL_DEL, item->fd, nullptr); // Removed instead of EPOLL_CTL_MOD with no events: EPOLLHUP would still be reported.
+                            continue;
+                        }
+                        item->alive = faux;
+                        ::epoll_ctl(efd, EPOLL_CTL_DEL, item->fd, nullptr); // The descriptor is still open here.
+                        if (item->done) item->done();
+                        auto lock = std::lock_guard{ mutex }; // Erase after done() to let _detach() wait for it.
+                        items.erase(token);
+                    }
+                }
+            }
+            // reactor: Watch the descriptor for readability (or writability). The handler is called in the reactor thread
+            //          and must not block; it returns faux to stop watching (e.g. on EOF), or calls pause() on backpressure
+            //          (or when there is nothing left to write).
+            auto _attach(fd_t fd, std::function<bool()> proc, std::function<void()> done, ui32 events)
+            {
+                auto guard = std::lock_guard{ mutex };
+                auto token = ++count;
+                auto item = ptr::shared<entry>();
+                item->fd = fd;
+                item->events = events;
+                item->token = token;
+                item->alive = true;
+                item->proc = std::move(proc);
+                item->done = std::move(done);
+                items[token] = item;
+                auto event = ::epoll_event{ .events = events, .data = { .u64 = token } };
+                if (!ok(::epoll_ctl(efd, EPOLL_CTL_ADD, fd, &event), "::epoll_ctl(EPOLL_CTL_ADD)", os::unexpected))
+                {
+                    items.erase(token);
+                    token = 0;
+                }
+                return token;
+            }
+            // reactor: Stop watching. Waits for the running handler to complete. Returns true if the
+            //          registration was still active (the handler has not returned faux yet).
+            //          Must not be called from the handler itself.
+            auto _detach(ui64 token)
+            {
+                auto item = sptr<entry>{};
+                {
+                    auto guard = std::lock_guard{ mutex };
+                    if (auto iter = items.find(token); iter != items.end())
+                    {
+                        item = iter->second;
+                        items.erase(iter);
+                    }
+                }
+                if (!item) return faux;
+                auto guard = std::lock_guard{ item->mutex };
+                if (!item->alive) return faux;
+                item->alive = faux;
+                if (!item->held) ::epoll_ctl(efd, EPOLL_CTL_DEL, item->fd, nullptr);
+                return true;
+            }
+            // reactor: Resume watching the descriptor paused by its handler. Waits for the running handler to complete.
+            //          Must not be called from the handler itself.
+            void _resume(ui64 token)
+            {
+                auto item = sptr<entry>{};
+                {
+                    auto guard = std::lock_guard{ mutex };
+                    if (auto iter = items.find(token); iter != items.end()) item = iter->second;
+                }
+                if (!item) return;
+                auto guard = std::lock_guard{ item->mutex };
+                if (!item->alive || !item->held.exchange(faux)) return;
+                auto event = ::epoll_event{ .events = item->events, .data = { .u64 = token } };
+                ok(::epoll_ctl(efd, EPOLL_CTL_ADD, item->fd, &event), "::epoll_ctl(EPOLL_CTL_ADD)", os::unexpected);
+            }
+            static auto& global()
+            {
+                static auto instance = reactor{};
+                return instance;
+            }
+            static auto attach(fd_t fd, std::function<bool()> proc, std::function<void()> done = {}, ui32 events = EPOLLIN)
+            {
+                return global()._attach(fd, std::move(proc), std::move(done), events);
+            }
+            static auto detach(ui64 token)
+            {
+                return global()._detach(token);
+            }
+            // reactor: Return the registration token of the running handler (called from the handler).
+            static auto current()
+            {
+                return running ? running->token : 0;
+            }
+            // reactor: Stop watching the descriptor of the running handler after it returns, e.g. on backpressure (called from the handler).
+            static void pause()
+            {
+                if (running) running->held = true;
+            }
+            static void resume(ui64 token)
+            {
+                global()._resume(token);
+            }
+        };
+
+        #endif
     }
 
     namespace env
@@ -3369,6 +3541,119 @@ namespace netxs::os
         }
     }
 
+    // os: Append-only storage in memory-mapped temporary files.
+    //     The files are deleted on close (on posix right after creation), so nothing is left behind.
+    struct spool
+    {
+        static constexpr auto segment_size = 64 * 1024 * 1024; // spool: Segment file size.
+
+        struct segment
+        {
+            char* data{}; // segment: Mapped memory.
+            ui32  used{}; // segment: Bytes written.
+            si32  alive{}; // segment: Number of records in use.
+            #if defined(_WIN32)
+            fd_t  mapfd{ os::invalid_fd }; // segment: File mapping handle.
+            #endif
+        };
+
+        std::vector<segment> parts; // spool: Segments. Released segments keep their index.
+        text                 label; // spool: File name prefix.
+        bool                 fault; // spool: The storage is unavailable.
+        std::error_code      ec;    // spool: Last file system error.
+
+        spool()
+            : label{ utf::concat("vtm-", os::process::id.first, "-", datetime::now().time_since_epoch().count(), "-") },
+              fault{ faux }
+        { }
+        spool(spool const&) = delete;
+       ~spool()
+        {
+            for (auto& s : parts) unmap(s);
+        }
+
+        // spool: Create a new segment file.
+        bool create()
+        {
+            auto& s = parts.emplace_back();
+            auto path = fs::temp_directory_path(ec) / (label + std::to_string(parts.size()));
+            if (ec) return faux;
+            #if defined(_WIN32)
+                auto fd = ::CreateFileW(path.wstring().c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_NEW,
+                                        FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE, nullptr);
+                if (fd == os::invalid_fd) return faux;
+                s.mapfd = ::CreateFileMappingW(fd, nullptr, PAGE_READWRITE, 0, segment_size, nullptr);
+                os::close(fd); // The mapping keeps the file open.
+                if (!s.mapfd) return faux;
+                s.data = (char*)::MapViewOfFile(s.mapfd, FILE_MAP_WRITE, 0, 0, 0);
+            #else
+                auto fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+                if (fd == os::invalid_fd) return faux;
+                ::unlink(path.c_str());
+                if (::ftruncate(fd, segment_size) == 0)
+                {
+                    auto data = ::mmap(nullptr, segment_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+                    if (data != MAP_FAILED) s.data = (char*)data;
+                }
+                os::close(fd); // The mapping keeps the file open.
+            #endif
+            return s.data;
+        }
+        // spool: Release segment memory and file.
+        void unmap(segment& s)
+        {
+            #if defined(_WIN32)
+                if (s.data) ::UnmapViewOfFile(s.data);
+                if (s.mapfd) os::close(s.mapfd);
+                s.mapfd = os::invalid_fd;
+            #else
+                if (s.data) ::munmap(s.data, segment_size);
+            #endif
+            s.data = {};
+        }
+        // spool: Store the record and return its reference (zero on failure).
+        ui64 append(view data)
+        {
+            auto size = sizeof(ui32) + data.size();
+            if (fault || size > segment_size) return 0;
+            if (parts.empty() || parts.back().used + size > segment_size)
+            {
+                if (parts.size() && parts.back().alive == 0) unmap(parts.back());
+                if (!create())
+                {
+                    fault = true;
+                    parts.pop_back();
+                    log(prompt::os, ansi::err("Scrollback spill storage is unavailable: ", ec.message()));
+                    return 0;
+                }
+            }
+            auto& s = parts.back();
+            auto addr = s.used;
+            auto head = (ui32)data.size();
+            std::memcpy(s.data + addr, &head, sizeof(head));
+            std::memcpy(s.data + addr + sizeof(head), data.data(), data.size());
+            s.used += (ui32)size;
+            s.alive++;
+            return ((ui64)parts.size() << 32) | addr; // Segment index is 1-based to keep the reference nonzero.
+        }
+        // spool: Return the record by reference.
+        view read(ui64 ref) const
+        {
+            auto& s = parts[(ref >> 32) - 1];
+            auto addr = s.data + (ui32)ref;
+            auto size = ui32{};
+            std::memcpy(&size, addr, sizeof(size));
+            return view{ addr + sizeof(size), size };
+        }
+        // spool: Release the record. Segments without records are unmapped.
+        void release(ui64 ref)
+        {
+            auto index = (ref >> 32) - 1;
+            auto& s = parts[index];
+            if (--s.alive == 0 && index + 1 != parts.size()) unmap(s);
+        }
+    };
+
     namespace ipc
     {
         //todo unify
@@ -3512,6 +3797,28 @@ namespace netxs::os
                     }
                     return qiew{};
                 }
+                auto read(char* buff, size_t size)
+                {
+                    auto guard = std::unique_lock{ mutex };
+                    wsync.wait(guard, [&]{ return store.size() || !alive || fired; });
+                    if (fired)
+                    {
+                        fired = faux;
+                    }
+                    else if (alive)
+                    {
+                        auto count = std::min(size, store.size());
+                        ::memcpy(buff, store.data(), count);
+                        store.erase(0, count);
+                        if (store.empty())
+                        {
+                            going = faux;
+                            going.notify_all();
+                        }
+                        return qiew{ buff, count };
+                    }
+                    return qiew{};
+                }
                 void wake()
                 {
                     fired = true;
@@ -3548,6 +3855,10 @@ namespace netxs::os
             {
                 server->wake();
             }
+            qiew recv(char* buff, size_t size) override
+            {
+                return server->read(buff, size);
+            }
             qiew recv() override
             {
                 return server->read(buffer);
@@ -4378,6 +4689,14 @@ namespace netxs::os
             text                    writebuf{};
             std::mutex              writemtx{};
             std::condition_variable writesyn{};
+            bool                    reactor{}; // vtty: Serve the link in the shared epoll thread instead of the reading, writing and stderr threads (Linux only).
+            #if defined(__linux__)
+            std::mutex              linkmtx{}; // vtty: Reactor registrations mutex.
+            std::array<ui64, 3>     watches{}; // vtty: Reactor registrations of the application output, input and stderr.
+            flag                    linked{}; // vtty: The link is served by the reactor.
+            bool                    parked{}; // vtty: The input has been written out and its watching is paused (guarded by writemtx).
+            std::function<void()>   finalize{}; // vtty: Report the disconnection (reactor mode).
+            #endif
 
             operator bool () { return attached; }
 
@@ -4389,6 +4708,16 @@ namespace netxs::os
             void payoff()
             {
                 if constexpr (debugmode) log(prompt::dtvt, "Destructor started");
+                #if defined(__linux__)
+                if (reactor)
+                {
+                    if (stdinput.joinable()) stdinput.join(); // The connecting thread ends as soon as the link is handed over to the reactor.
+                    if (attached.exchange(faux)) unlink(-1);
+                    linked.wait(true); // The reactor may still be reporting the disconnection.
+                    if constexpr (debugmode) log(prompt::dtvt, "Destructor complete");
+                    return;
+                }
+                #endif
                 if (attached.exchange(faux)) // Detach child process and forget.
                 {
                     writesyn.notify_one(); // Interrupt writing thread.
@@ -4445,6 +4774,104 @@ namespace netxs::os
                 }
                 if constexpr (debugmode) log(prompt::dtvt, "Errlogs thread ended", ' ', utf::to_hex_0x(std::this_thread::get_id()));
             }
+            #if defined(__linux__)
+            // vtty: Write out the pending input without blocking (reactor mode).
+            bool flush()
+            {
+                auto guard = std::lock_guard{ writemtx };
+                while (writebuf.size())
+                {
+                    auto size = ::write(termlink.handle.w, writebuf.data(), writebuf.size());
+                    if (size > 0) writebuf.erase(0, size);
+                    else if (size < 0 && errno == EINTR) continue;
+                    else if (size < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return true; // Wait until the pipe is drained.
+                    else
+                    {
+                        if constexpr (debugmode) log(prompt::dtvt, "Unexpected disconnection");
+                        return faux;
+                    }
+                }
+                parked = true;
+                io::reactor::pause(); // Nothing left to write.
+                return true;
+            }
+            // vtty: Stop serving the link and report the disconnection. Called once by the side that has cleared the attached flag.
+            //       self is the index of the registration whose handler has just ended (-1 if called outside the reactor).
+            void unlink(si32 self)
+            {
+                auto tokens = [&]
+                {
+                    auto guard = std::lock_guard{ linkmtx }; // Wait for serve() to complete the registrations.
+                    return std::exchange(watches, {});
+                }();
+                for (auto i = 0; i < (si32)tokens.size(); i++)
+                {
+                    if (i != self && tokens[i]) io::reactor::detach(tokens[i]);
+                }
+                termlink.shut();
+                if (finalize) std::exchange(finalize, {})();
+                linked.exchange(faux);
+                linked.notify_all();
+            }
+            // vtty: Hand the link over to the shared reactor. Return faux if the descriptors cannot be watched.
+            //       The received frames are passed to ingest_fx, which queues them for handling outside the reactor thread
+            //       and returns faux if the reading should be paused until the passed resume function is called.
+            bool serve(text cmd, auto ingest_fx, auto shutdown_fx)
+            {
+                auto guard = std::lock_guard{ linkmtx };
+                auto& handle = termlink.handle;
+                auto flags = ::fcntl(handle.w, F_GETFL);
+                ::fcntl(handle.w, F_SETFL, flags | O_NONBLOCK); // The input pipe end is only ours.
+                linked.exchange(true);
+                finalize = [&, cmd, shutdown_fx]
+                {
+                    log("%%Process '%cmd%' disconnected", prompt::dtvt, ansi::hi(utf::debase437(cmd)));
+                    shutdown_fx();
+                };
+                if (handle.e != os::invalid_fd)
+                {
+                    watches[2] = io::reactor::attach(handle.e, [&, cached = text{}, buffer = text(os::pipebuf, '\0')]() mutable
+                    {
+                        auto shot = io::recv(handle.e, buffer);
+                        if (!shot) return faux;
+                        cached += shot;
+                        auto crop = qiew{ cached };
+                        utf::purify(crop);
+                        if (crop)
+                        {
+                            log("%%stderr[%stderrid%]: %msg%", prompt::dtvt, stderrid, ansi::err(crop));
+                            cached.erase(0, crop.size()); // Delete processed data.
+                        }
+                        return true;
+                    });
+                }
+                watches[1] = io::reactor::attach(handle.w, [&]{ return flush(); }, [&]{ if (attached.exchange(faux)) unlink(1); }, EPOLLOUT);
+                if (watches[1]) // The application output is watched last: it ends the link.
+                {
+                    watches[0] = io::reactor::attach(handle.r, [&, ingest_fx, frames = directvt::binary::stream::reader{}]() mutable
+                    {
+                        auto token = io::reactor::current();
+                        return frames.step(termlink, [&](qiew data)
+                        {
+                            if (!ingest_fx(data, [token]{ io::reactor::resume(token); })) // The shared thread never waits for the frame handlers.
+                            {
+                                io::reactor::pause(); // Stop reading until the backlog is handled.
+                            }
+                        });
+                    },
+                    [&]{ if (attached.exchange(faux)) unlink(0); });
+                }
+                if (!watches[0]) // Fall back to the threads.
+                {
+                    for (auto token : std::exchange(watches, {})) if (token) io::reactor::detach(token);
+                    ::fcntl(handle.w, F_SETFL, flags);
+                    finalize = {};
+                    linked.exchange(faux);
+                    return faux;
+                }
+                return true;
+            }
+            #endif
             auto create_dtvt_process(eccc cfg, fdrw fds)
             {
                 log("%%New process '%cmd%' at the %path%", prompt::dtvt, ansi::hi(utf::debase437(cfg.cmd)), cfg.cwd.empty() ? "current directory"s : "'" + utf::debase437(cfg.cwd) + "'");
@@ -4575,9 +5002,9 @@ namespace netxs::os
                 }
                 return result;
             }
-            void run_dtvt_app(eccc& appcfg, twod initsize, auto connect_fx, auto receiver_fx, auto shutdown_fx)
+            void run_dtvt_app(eccc& appcfg, twod initsize, auto connect_fx, auto receiver_fx, auto ingest_fx, auto shutdown_fx)
             {
-                stdinput = std::thread{ [&, appcfg, initsize, connect_fx, receiver_fx, shutdown_fx]
+                stdinput = std::thread{ [&, appcfg, initsize, connect_fx, receiver_fx, ingest_fx, shutdown_fx]
                 {
                     auto [s_pipe_r, m_pipe_w] = os::ipc::newpipe();
                     auto [m_pipe_r, s_pipe_w] = os::ipc::newpipe();
@@ -4613,6 +5040,12 @@ namespace netxs::os
                         attached.exchange(true);
                         stderrid = (arch)termlink.handle.e;
                         if constexpr (debugmode) log("%%DirectVT Gateway [%stderrid%] created for process '%cmd%'", prompt::dtvt, stderrid, ansi::hi(utf::debase437(cmd)));
+                        #if defined(__linux__)
+                        if (reactor && serve(cmd, ingest_fx, shutdown_fx)) return;
+                        reactor = faux;
+                        #else
+                        (void)ingest_fx;
+                        #endif
                         auto stdwrite = std::thread{ [&]{ writer(); } };
                         auto stderror = std::thread{ [&]{ errlog(); } };
 
@@ -4634,8 +5067,20 @@ namespace netxs::os
             }
             void output(view data)
             {
-                auto guard = std::lock_guard{ writemtx };
+                auto guard = std::unique_lock{ writemtx };
                 writebuf += data;
+                #if defined(__linux__)
+                if (reactor)
+                {
+                    if (std::exchange(parked, faux))
+                    {
+                        guard.unlock(); // The writing handler takes writemtx.
+                        auto token = [&]{ auto lock = std::lock_guard{ linkmtx }; return watches[1]; }();
+                        if (token) io::reactor::resume(token);
+                    }
+                    return;
+                }
+                #endif
                 writesyn.notify_one();
             }
         };
@@ -6749,6 +7194,7 @@ namespace netxs::os
             proxy.header.set(id_t{}, title);
             proxy.footer.set(id_t{}, ""s);
             proxy.mousebar.send(intio, !!(dtvt::vtmode & ui::console::mouse));
+            if (dtvt::vtmode & ui::console::nt16) proxy.features.send(intio, directvt::binary::feature::runs); // The bitmap is decoded locally in nt16 mode.
 
             auto alarm = fire{};
             auto alive = flag{ true };
@@ -270,6 +270,8 @@ namespace netxs::ui
             si32 def_find_f;
 
             bool def_alt_on;
+            bool def_spills;
+            bool def_poller;
 
             text send_input;
 
@@ -311,6 +313,8 @@ namespace netxs::ui
                 resetonkey =             config.settings::take("/config/terminal/scrollback/reset/onkey",     true);
                 resetonout =             config.settings::take("/config/terminal/scrollback/reset/onoutput",  faux);
                 def_alt_on =             config.settings::take("/config/terminal/scrollback/altscroll",       true);
+                def_spills =             config.settings::take("/config/terminal/scrollback/spill",           faux);
+                def_poller =             config.settings::take("/config/terminal/reactor",                    faux);
                 def_margin = std::max(0, config.settings::take("/config/terminal/scrollback/oversize",        si32{ 0 }    ));
                 def_tablen = std::max(1, config.settings::take("/config/terminal/tablen",                     si32{ 8 }    ));
                 def_border = std::max(0, config.settings::take("/config/terminal/border",                     si32{ 0 }    ));
@@ -3646,6 +3650,8 @@ namespace netxs::ui
             struct buff : public ring
             {
                 static constexpr auto sizea_size = 65536;
+                static constexpr auto cold_depth = 512; // buff: Minimal distance from the bottom at which lines are packed.
+                static constexpr auto thaw_limit = 4096; // buff: Number of unpacked cold lines to keep.
                 using type = deco::type;
                 using mapa = std::array<si32, sizea_size>[type::count];
                 using maps = std::map<si32, si32>[type::count];
@@ -3665,10 +3671,15 @@ namespace netxs::ui
                 si32 ancdy{}; // buff: Slide's top line offset.
                 bool round{}; // buff: Is the slide position approximate.
                 bool rolls{}; // buff: The scrollback buffer ring was scrolled.
+                si32 depth{ cold_depth }; // buff: Distance from the bottom at which lines are packed.
+                std::deque<id_t> thawn; // buff: Ids of the cold lines unpacked on access.
+                bool chill{}; // buff: Repacking of the unpacked cold lines is scheduled.
+                netxs::sptr<os::spool> spill; // buff: Disk storage for the packed cold lines (optional).
 
                 buff(term& boss)
                     : ring{ boss.defcfg.def_length, boss.defcfg.def_growdt, boss.defcfg.def_growmx },
-                      owner{ boss }
+                      owner{ boss },
+                      spill{ boss.defcfg.def_spills ? ptr::shared<os::spool>() : nullptr }
                 { }
                 // buff: Decrease height.
                 void dec_height(si32& block_vsize, si32 line_kind, si32 line_size)
@@ -3784,6 +3795,7 @@ namespace netxs::ui
                 {
                     auto old_value = vsize;
                     set_width(new_size.x);
+                    depth = std::max(cold_depth, new_size.y * 2);
                     if (ring::peak <= new_size.y)
                     {
                         static constexpr auto BottomAnchored = true;
@@ -3791,13 +3803,49 @@ namespace netxs::ui
                     }
                     return old_value != vsize;
                 }
+                // buff: Unpack the cold line on access.
+                void access_base(line& l) override
+                {
+                    if (l.spilled())
+                    {
+                        auto ref = l.spill_ref();
+                        l.thaw(spill->read(ref));
+                        spill->release(ref);
+                        thawn.push_back(l.index);
+                    }
+                    else if (l.frozen())
+                    {
+                        l.thaw();
+                        thawn.push_back(l.index);
+                    }
+                    else return;
+                    if (thawn.size() > thaw_limit && !std::exchange(chill, true)) // Read-only passes (search, selection) do not push lines, so the repacking is deferred: the caller may still hold references to the unpacked lines.
+                    {
+                        owner.enqueue([&](auto& /*boss*/)
+                        {
+                            chill = faux;
+                            repack();
+                        });
+                    }
+                }
+                // buff: Release the disk storage record of the spilled line and drop its packed data.
+                void release(line& l)
+                {
+                    if (l.spilled())
+                    {
+                        spill->release(l.spill_ref());
+                        text().swap(l.frost);
+                    }
+                }
                 // buff: Push a new line to the buffer back.
                 template<class ...Args>
                 auto& invite(Args&&... args)
                 {
                     auto& l = ring::push_back();
+                    release(l);
                     l.reinitialize(std::forward<Args>(args)...);
                     invite(l);
+                    freeze();
                     return l;
                 }
                 // buff: Insert a new line to the specified position.
@@ -3805,6 +3853,7 @@ namespace netxs::ui
                 auto& insert(si32 at, Args&&... args)
                 {
                     auto& l = *ring::insert(at);
+                    release(l);
                     l.reinitialize(std::forward<Args>(args)...);
                     invite(l);
                     return l;
@@ -3817,8 +3866,9 @@ namespace netxs::ui
                         l.set_image_sixel(faux);
                         owner.sixel_run_accounting(l.cells);
                     }
+                    release(l);
                     l.cells.clear();
-                    if (deallocate || l.cells.capacity() > 256) // Deallocate long lines (256*sizeof(cell)=10240bytes).
+                    if (deallocate || l.frozen() || l.cells.capacity() > 256) // Deallocate long lines (256*sizeof(cell)=10240bytes).
                     {
                         l.deallocate();
                     }
@@ -3855,7 +3905,40 @@ namespace netxs::ui
                 {
                     //No need to disturb distant objects, it may already be in the swap.
                     auto total = length();
-                    return (si32)(total - 1 - (back().index - item_id)); // ring buffer size is never larger than max_int32.
+                    return (si32)(total - 1 - (ring::buff[ring::tail].index - item_id)); // ring buffer size is never larger than max_int32.
+                }
+                // buff: Pack the line and move it to the disk storage if it is enabled.
+                void freeze(line& l)
+                {
+                    l.freeze();
+                    if (spill && l.frozen() && !l.spilled())
+                    {
+                        if (auto ref = spill->append(l.packed())) l.spill(ref);
+                    }
+                }
+                // buff: Pack the line that has gone deep enough and the oldest unpacked cold lines.
+                void freeze()
+                {
+                    auto limit = length() - depth;
+                    if (limit <= 0) return;
+                    freeze(ring::peek(limit - 1));
+                    repack();
+                }
+                // buff: Repack the least recently unpacked cold lines beyond the limit, except for the lines around the viewport.
+                void repack()
+                {
+                    auto limit = length() - depth;
+                    auto shown = index_by_id(ancid);
+                    auto count = thawn.size();
+                    while (thawn.size() > thaw_limit && count--)
+                    {
+                        auto line_id = thawn.front();
+                        auto i = index_by_id(line_id); // The id may be stale after the line removal, so it is checked.
+                        thawn.pop_front();
+                        if (i < 0 || i >= limit) continue;
+                        if (i >= shown && i < shown + depth / 2) thawn.push_back(line_id); // The viewport height is at most depth / 2.
+                        else                                     freeze(ring::peek(i));
+                    }
                 }
                 // buff: Return an iterator pointing to the item with the specified id.
                 auto iter_by_id(id_t line_id) -> ring::iter<ring> //todo MSVC 17.7.0 requires return type
@@ -3872,24 +3955,19 @@ namespace netxs::ui
                 {
                     if (from >= 0)
                     {
-                        auto a = begin() + from;
-                        auto b = end();
-                        auto i = from == 0 ? 0 : (a - 1)->index + 1;
-                        while (a != b)
+                        auto i = from == 0 ? 0 : ring::peek(from - 1).index + 1;
+                        while (from < length())
                         {
-                            a->index = i++;
-                            ++a;
+                            ring::peek(from++).index = i++;
                         }
                     }
                     else
                     {
-                        auto a = begin();
-                        auto b = a + std::abs(from);
-                        auto i = b->index - std::abs(from);
-                        while (a != b)
+                        auto n = std::abs(from);
+                        auto i = ring::peek(n).index - n;
+                        for (auto a = 0; a < n; a++)
                         {
-                            a->index = i++;
-                            ++a;
+                            ring::peek(a).index = i++;
                         }
                     }
                 }
@@ -3904,7 +3982,8 @@ namespace netxs::ui
                 void clear()
                 {
                     auto auto_wrap = current().wrapped();
-                    ring::clear();
+                    ring::clear(); // The spilled lines are released by _clear_line().
+                    thawn.clear();
                     caret = 0;
                     basis = 0;
                     slide = 0;
@@ -3923,7 +4002,8 @@ namespace netxs::ui
                     auto old_state = backup.get_state();
                     recalc(curln, old_state); // Detach current line.
                     backup.index = 0;
-                    ring::clear();
+                    ring::clear(); // The spilled lines are released by _clear_line().
+                    thawn.clear();
                     auto& newln = ring::push_back();
                     newln = std::move(backup); // Attach current line.
                     basis = 0;
@@ -4902,6 +4982,7 @@ namespace netxs::ui
                         auto oldsz = batch.size;
                         auto proto = std::span{ curit, (size_t)size.x };
                         auto& curln = *batch.ring::insert(start);
+                        batch.release(curln);
                         curln.reinitialize(curid++, new_style, proto);
                         curln.trim_blank_cells(block.mark());
                         batch.invite(curln);
@@ -6147,6 +6228,7 @@ namespace netxs::ui
                     auto endit = batch.end();
                     auto& newln = *curit;
                     auto& tmpln = *(curit - 1);
+                    batch.release(newln);
                     newln.reinitialize(tmpln.index, tmpln.get_style(), parser::brush);
                     newln.splice1(0, tmpln.substr(start), cell::shaders::full, brush.spc());
                     auto old_state = tmpln.get_state();
@@ -7965,15 +8047,29 @@ namespace netxs::ui
             std::vector<argb> bitmap; // Sixel bitmap buffer.
             std::vector<argb> palette = std::vector<argb>(sixel_t::def_palette_size); // Sixel palette.
             twod              cur_image_limits = def_image_limits;
+            bool              active{}; // The image is being decoded. Its payload may arrive in parts.
+            si32              aspect_ratio{};
+            si32              transparent{};
+            bool              implicit_size{};
+            twod              size;
+            si32              stride{};
+            si32              cur_map{};
+            argb              cur_fgc;
+            argb              background_clr;
+            si32              coor{};
+            si32              maxx{};
+            si32              maxy{};
+            si32              line{};
 
             void clear_state()
             {
                 palette.assign(sixel_t::def_palette_size, 0);
                 cur_image_limits = def_image_limits;
+                active = faux;
             }
-            void parse(qiew& q, auto& params)
+            // sixel_t: Start decoding a new image.
+            void start(auto& params)
             {
-                auto ok = faux;
                 // aspect_ratio:
                 // omitted     2:1
                 // 0 or 1      5:1
@@ -7983,55 +8079,113 @@ namespace netxs::ui
                 // 7,8, or 9   1:1
                 //                                        -1  0  1  2  3  4  5  6  7  8  9
                 static constexpr auto ar = std::to_array({ 2, 5, 5, 3, 2, 2, 2, 2, 1, 1, 1 });
-                auto aspect_ratio = ar[std::clamp(params[0] + 1, 0, (si32)ar.size() - 1)];
+                aspect_ratio = ar[std::clamp(params[0] + 1, 0, (si32)ar.size() - 1)];
                 // transparent:
                 // omitted     opaque  0's are filled with current background color
                 // 0 or 2      opaque
                 // 1           transparent   0's are kept intact
                 //                                        -1  0  1  2
                 static constexpr auto tr = std::to_array({ 0, 0, 1, 0 });
-                auto transparent = tr[std::clamp(params[1] + 1, 0, (si32)tr.size() - 1)];
+                transparent = tr[std::clamp(params[1] + 1, 0, (si32)tr.size() - 1)];
                 // hz_grid_size: We ignore it.
                 // n
                 //auto hz_grid_size = params[2];
-                auto size = owner.target->panel * ansi::cellsz;
-                auto implicit_size = true;
+                size = owner.target->panel * ansi::cellsz;
+                implicit_size = true;
                 //size.y *= aspect_ratio; // Don't scale max image size.
-                auto stride = size.x * aspect_ratio * 6;
-                auto cur_map = 0;
+                stride = size.x * aspect_ratio * 6;
+                cur_map = 0;
                 auto cur_clr = owner.target->get_effective_brush();
-                auto cur_fgc = cur_clr.fgc();
+                cur_fgc = cur_clr.fgc();
                 auto cur_bgc = cur_clr.bgc();
                 if (cur_clr.inv()) std::swap(cur_fgc, cur_bgc);
-                bitmap.clear();
-                auto coor = 0;
-                auto maxx = size.x;
-                auto maxy = size.x * size.y;
-                auto line = 0;
-                auto print_sixel = [&](si32 c)
+                bitmap.clear(); // Keep the capacity for the next image.
+                coor = 0;
+                maxx = size.x;
+                maxy = size.x * size.y;
+                line = 0;
+                background_clr = transparent ? argb{} : cur_bgc;
+                active = true;
+            }
+            void canvas()
+            {
+                if (bitmap.empty()) [[unlikely]] { bitmap.assign(size.x * size.y, background_clr); }
+            }
+            // sixel_t: Print a run of sixels band-wise, pixel row by pixel row.
+            void print(qiew run)
+            {
+                canvas();
+                auto n = std::min((si32)run.size(), maxx - coor);
+                if (n <= 0) return;
+                auto data = run.data();
+                auto bits = 0;
+                for (auto i = 0; i < n; i++) bits |= data[i] - '?';
+                for (auto b = 0; bits; b++, bits >>= 1)
                 {
-                    if (coor < maxx)
+                    if ((bits & 1) == 0) continue;
+                    for (auto y = 0; y < aspect_ratio; y++)
                     {
-                        auto offset = coor++;
-                        while (c)
+                        auto offset = coor + (b * aspect_ratio + y) * size.x;
+                        if (offset >= maxy) break;
+                        auto dst = bitmap.data() + offset;
+                        for (auto i = 0; i < n; i++)
                         {
-                            if (c & 1)
-                            {
-                                for (auto y = 0; y < aspect_ratio; y++)
-                                {
-                                    if (offset < maxy) bitmap[offset] = cur_fgc;
-                                    offset += size.x;
-                                }
-                            }
-                            else
-                            {
-                                offset += size.x * aspect_ratio;
-                            }
-                            c >>= 1;
+                            dst[i] = (data[i] - '?') >> b & 1 ? cur_fgc : dst[i]; // Branchless to let it vectorize.
                         }
                     }
-                };
-                auto background_clr = transparent ? argb{} : cur_bgc;
+                }
+                coor += n;
+            }
+            // sixel_t: Print the sixel c count times.
+            void print(si32 c, si32 count)
+            {
+                auto n = std::min(count, maxx - coor);
+                if (n <= 0) return;
+                for (auto b = 0; c; b++, c >>= 1)
+                {
+                    if ((c & 1) == 0) continue;
+                    for (auto y = 0; y < aspect_ratio; y++)
+                    {
+                        auto offset = coor + (b * aspect_ratio + y) * size.x;
+                        if (offset >= maxy) break;
+                        std::fill_n(bitmap.data() + offset, n, cur_fgc);
+                    }
+                }
+                coor += n;
+            }
+            // sixel_t: Return the leading part of the sixel payload that can be decoded without waiting for more data.
+            static auto ready(view data)
+            {
+                auto stop = data.find_first_of("\x1b\a\x18\x1a"sv); // ST, BEL, CAN or SUB.
+                if (stop != view::npos)
+                {
+                    if (data[stop] != '\x1b') return data.substr(0, stop + 1);
+                    else                      return data.substr(0, stop + 1 < data.size() ? stop + 2 : stop);
+                }
+                auto last = data.size(); // Cut after the last sixel, '-' or '$', or before the last '#', '!' or '"', since numeric parameters may continue in the next part.
+                while (last)
+                {
+                    auto c = data[last - 1];
+                    if ((c >= '?' && c <= '~') || c == '-' || c == '$') break;
+                    last--;
+                    if (c == '#' || c == '!' || c == '"') break; // A palette-only payload has nothing but color introducers to cut at.
+                }
+                return data.substr(0, last);
+            }
+            void parse(qiew& q, auto& params)
+            {
+                start(params);
+                decode(q);
+                if (active)
+                {
+                    active = faux;
+                    if constexpr (debugmode) log("sixel incomplete");
+                }
+            }
+            // sixel_t: Decode the next part of the payload and show the image on ST.
+            void decode(qiew& q)
+            {
+                auto ok = faux;
                 //auto hash = ui64{};
                 auto head = q.begin();
                 auto tail = q.end();
@@ -8040,13 +8194,13 @@ namespace netxs::ui
                     auto c = *head++;
                     if (c >= '?' && c <= '~') // Print sixels.
                     {
-                        if (bitmap.empty()) [[unlikely]] { bitmap.assign(size.x * size.y, background_clr); }
-                        c -= '?';
-                        print_sixel(c);
+                        auto from = head - 1;
+                        while (head != tail && *head >= '?' && *head <= '~') head++;
+                        print(qiew{ from, head });
                     }
                     else if (c == '!') // Repeat sixels.
                     {
-                        if (bitmap.empty()) [[unlikely]] { bitmap.assign(size.x * size.y, background_clr); }
+                        canvas();
                         auto q2 = qiew{ head, tail };
                         if (auto v = utf::to_int(q2))
                         {
@@ -8057,8 +8211,7 @@ namespace netxs::ui
                                 {
                                     q2.pop_front();
                                     c2 -= '?';
-                                    auto count = std::max(0, v.value());
-                                    while (count--) print_sixel(c2);
+                                    print(c2, v.value());
                                 }
                             }
                         }
@@ -8130,6 +8283,7 @@ namespace netxs::ui
                     {
                         //if constexpr (debugmode) log("sixel complete");
                         ok = true;
+                        active = faux;
                         break;
                     }
                     //else if (c == '\x1b') //todo Escape sequence inside sixels. ?Should we parse it?
@@ -8141,6 +8295,7 @@ namespace netxs::ui
                     else if (c == ansi::c0_can || c == ansi::c0_sub) // Abort.
                     {
                         if constexpr (debugmode) log("sixel aborted");
+                        active = faux;
                         break;
                     }
                     else
@@ -8149,94 +8304,106 @@ namespace netxs::ui
                     }
                 }
                 q = qiew{ head, tail };
-                if (ok) // Show image.
-                {
-                    auto area = rect{ dot_00, size };
-                    auto doc_str = term::rgba_to_svg(bitmap, area, implicit_size, background_clr, transparent);
-                    auto fp_rc = fp2d{ area.coor } / fp2d{ ansi::cellsz }; // Position in cell grid.
-                    auto fp_wh = fp2d{ area.size } / fp2d{ ansi::cellsz }; // Size in cells.
-                    auto rc = twod{ std::floor(fp_rc) };
-                    auto fp_xy = fp_rc - rc; // Offset inside the cell grid.
-                    auto wh = twod{ std::ceil(fp_wh + fp_xy - 0.0001f/*compensate fp32 jitter*/) };
-                    auto gb_attr_x  = fp_xy.x;
-                    auto gb_attr_y  = fp_xy.y;
-                    auto gb_attr_w  = fp_wh.x;
-                    auto gb_attr_h  = fp_wh.y;
-                    auto gb_attr_u  = 0.f;
-                    auto gb_attr_v  = 0.f;
-                    auto gb_attr_uw = 1.f;
-                    auto gb_attr_vh = 1.f;
-                    auto images = cell::images(); // Lock.
-                    auto c = owner.target->cell_under_cursor(rc);
-                    if (auto index = c.get_image_index()) // Check the image id at the current cursor position.
-                    {
-                        auto prev_cr = c.get_image_cr();
-                        auto prev_WH = c.get_image_WH();
-                        if (prev_cr == dot_11 && prev_WH == wh) // Update existing image.
-                        {
-                            if (auto image_ptr = images.map[index])
-                            {
-                                auto& image = *image_ptr;
-                                image.reset_changes();
-                                image.check_and_set_document(doc_str);
-                                image.check_and_set_attr(imagens::gb::x , gb_attr_x);
-                                image.check_and_set_attr(imagens::gb::y , gb_attr_y);
-                                image.check_and_set_attr(imagens::gb::w , gb_attr_w);
-                                image.check_and_set_attr(imagens::gb::h , gb_attr_h);
-                                if (image.document_changed || image.changed_gb_attrs)
-                                {
-                                    image.stamp += 1;
-                                    owner.base::signal(tier::general, e2::data::image::update, index);
-                                }
-                                owner.print_sixel_image(image, rc, wh, transparent);
-                                return;
-                            }
-                            else
+                if (ok) show();
+            }
+            // sixel_t: Post the decoded image.
+            void show()
+            {
+                auto area = rect{ dot_00, size };
+                auto doc_str = term::rgba_to_svg(bitmap, area, implicit_size, background_clr, transparent);
+                auto fp_rc = fp2d{ area.coor } / fp2d{ ansi::cellsz }; // Position in cell grid.
+                auto fp_wh = fp2d{ area.size } / fp2d{ ansi::cellsz }; // Size in cells.
+                auto rc = twod{ std::floor(fp_rc) };
+                auto fp_xy = fp_rc - rc; // Offset inside the cell grid.
+                auto wh = twod{ std::ceil(fp_wh + fp_xy - 0.0001f/*compensate fp32 jitter*/) };
+                auto gb_attr_x  = fp_xy.x;
+                auto gb_attr_y  = fp_xy.y;
+                auto gb_attr_w  = fp_wh.x;
+                auto gb_attr_h  = fp_wh.y;
+                auto gb_attr_u  = 0.f;
+                auto gb_attr_v  = 0.f;
+                auto gb_attr_uw = 1.f;
+                auto gb_attr_vh = 1.f;
+                auto images = cell::images(); // Lock.
+                auto c = owner.target->cell_under_cursor(rc);
+                if (auto index = c.get_image_index()) // Check the image id at the current cursor position.
+                {
+                    auto prev_cr = c.get_image_cr();
+                    auto prev_WH = c.get_image_WH();
+                    if (prev_cr == dot_11 && prev_WH == wh) // Update existing image.
+                    {
+                        if (auto image_ptr = images.map[index])
+                        {
+                            auto& image = *image_ptr;
+                            image.reset_changes();
+                            image.check_and_set_document(doc_str);
+                            image.check_and_set_attr(imagens::gb::x , gb_attr_x);
+                            image.check_and_set_attr(imagens::gb::y , gb_attr_y);
+                            image.check_and_set_attr(imagens::gb::w , gb_attr_w);
+                            image.check_and_set_attr(imagens::gb::h , gb_attr_h);
+                            if (image.document_changed || image.changed_gb_attrs)
                             {
-                                if (owner.io_log) log("%%Broken image index: %%", prompt::term, index);
+                                image.stamp += 1;
+                                owner.base::signal(tier::general, e2::data::image::update, index);
                             }
+                            owner.print_sixel_image(image, rc, wh, transparent);
+                            return;
+                        }
+                        else
+                        {
+                            if (owner.io_log) log("%%Broken image index: %%", prompt::term, index);
                         }
                     }
-                    // Post a new image.
-                    //todo cache  auto iter = image_cache.find(doc_str); iter != image_cache.end();
-                    auto image_ptr = ptr::shared(imagens::image{ .document = doc_str });
-                    if (auto image_index = images.set(image_ptr))
-                    {
-                        auto& image = *image_ptr;
-                        image.id = "Sixel_"; // Set id="Sixel_FFFF".
-                        utf::to_hex(image_index, image.id);
-                        image.index = image_index;
-                        image.gb_attrs[imagens::gb::x  ] = gb_attr_x;
-                        image.gb_attrs[imagens::gb::y  ] = gb_attr_y;
-                        image.gb_attrs[imagens::gb::u  ] = gb_attr_u;
-                        image.gb_attrs[imagens::gb::v  ] = gb_attr_v;
-                        image.gb_attrs[imagens::gb::w  ] = gb_attr_w;
-                        image.gb_attrs[imagens::gb::h  ] = gb_attr_h;
-                        image.gb_attrs[imagens::gb::uw ] = gb_attr_uw;
-                        image.gb_attrs[imagens::gb::vh ] = gb_attr_vh;
-                        image.gb_attrs[imagens::gb::fit] = scale_mode::stretch;
-                        owner.image_sixel_count++;
-                        owner.print_sixel_image(image, rc, wh, transparent);
-                        // All sixel images will be removed on undock.
-                        //owner.sixel_cache[image.id] = image_ptr;
-                    }
-                    //todo sync original fragments
-                    //todo add a bitmap raster bit (introduce payload category: svg, raw, ...) to the imagens::image
-                    //todo store the payload in byts instead of text
-                    //todo implement own bitmap (raw category) rasterization (with interpolation)
-                    //todo hashing by sixel_string
                 }
-                else
+                // Post a new image.
+                //todo cache  auto iter = image_cache.find(doc_str); iter != image_cache.end();
+                auto image_ptr = ptr::shared(imagens::image{ .document = doc_str });
+                if (auto image_index = images.set(image_ptr))
                 {
-                    if constexpr (debugmode) log("sixel incomplete");
-                }
+                    auto& image = *image_ptr;
+                    image.id = "Sixel_"; // Set id="Sixel_FFFF".
+                    utf::to_hex(image_index, image.id);
+                    image.index = image_index;
+                    image.gb_attrs[imagens::gb::x  ] = gb_attr_x;
+                    image.gb_attrs[imagens::gb::y  ] = gb_attr_y;
+                    image.gb_attrs[imagens::gb::u  ] = gb_attr_u;
+                    image.gb_attrs[imagens::gb::v  ] = gb_attr_v;
+                    image.gb_attrs[imagens::gb::w  ] = gb_attr_w;
+                    image.gb_attrs[imagens::gb::h  ] = gb_attr_h;
+                    image.gb_attrs[imagens::gb::uw ] = gb_attr_uw;
+                    image.gb_attrs[imagens::gb::vh ] = gb_attr_vh;
+                    image.gb_attrs[imagens::gb::fit] = scale_mode::stretch;
+                    owner.image_sixel_count++;
+                    owner.print_sixel_image(image, rc, wh, transparent);
+                    // All sixel images will be removed on undock.
+                    //owner.sixel_cache[image.id] = image_ptr;
+                }
+                //todo sync original fragments
+                //todo add a bitmap raster bit (introduce payload category: svg, raw, ...) to the imagens::image
+                //todo store the payload in byts instead of text
+                //todo implement own bitmap (raw category) rasterization (with interpolation)
+                //todo hashing by sixel_string
             }
         };
 
+        // term: Accumulated PTY output.
+        struct inbox_t
+        {
+            std::mutex              mutex; // inbox_t: Access mutex.
+            std::condition_variable synch; // inbox_t: Backlog drain notificator.
+            text                    block; // inbox_t: Output that has not been parsed yet.
+            bool                    await{}; // inbox_t: Parsing is scheduled.
+            std::function<void()>   thaw; // inbox_t: Resume the non-blocking reader paused on the backlog limit.
+        };
+
         using prot = input::keybd::prot;
         using buffer_ptr = bufferbase*;
         using vtty = os::vt::vtty;
 
+        static constexpr auto inbox_chunk = 4 * os::pipebuf; // term: Bytes parsed at once.
+        static constexpr auto inbox_limit = 16 * os::pipebuf; // term: Backlog size at which the reading thread is throttled.
+        static constexpr auto inbox_quota = std::chrono::milliseconds{ 4 }; // term: Parsing time before yielding to other objects and rendering.
+
         std::array<face, 5> pocket; // term: Buffers for DECCRA.
         termconfig defcfg; // term: Terminal settings.
         scroll_buf normal; // term: Normal    screen buffer.
@@ -8289,6 +8456,7 @@ namespace netxs::ui
         std::vector<ui16>                                     image_removed_indexes; // term: Image indexes to be deleted.
         text       deadkey_preview; // term: Deadkey preview.
         sixel_t    sixels; // term: Sixel mode state.
+        inbox_t    inbox; // term: PTY output ingestion buffer.
         vtty       ipccon; // term: IPC connector. Should be destroyed first.
 
         // term: Print the block to the scrollback buffer with scroll.
@@ -9578,6 +9746,110 @@ namespace netxs::ui
                 return ondata_direct<Forced>(data, target_buffer);
             });
         }
+        // term: Accumulate PTY output and schedule its parsing (called from the reading thread).
+        void ingest(view data)
+        {
+            auto guard = std::unique_lock{ inbox.mutex };
+            if (inbox.block.size() > inbox_limit) // Throttle the reading thread. The wait is bounded because the task queue may be busy joining this thread.
+            {
+                inbox.synch.wait_for(guard, inbox_quota * 4);
+            }
+            enlist(data);
+        }
+        // term: Accumulate PTY output without waiting (called from the shared reactor thread).
+        //       Return faux if the backlog is over the limit: the reader should stop reading until the parser calls resume().
+        bool ingest(view data, std::function<void()> resume)
+        {
+            auto guard = std::lock_guard{ inbox.mutex };
+            enlist(data);
+            if (inbox.block.size() <= inbox_limit) return true;
+            inbox.thaw = std::move(resume);
+            return faux;
+        }
+        // term: Append PTY output to the inbox and schedule its parsing (called under the inbox lock).
+        void enlist(view data)
+        {
+            inbox.block += data;
+            if (!std::exchange(inbox.await, true))
+            {
+                base::enqueue([&](auto& /*boss*/){ digest(); });
+            }
+        }
+        // term: Parse the accumulated PTY output in batches within the time quota and reschedule the rest.
+        //       Intermediate states between batches are not rendered, only the viewport state at the next frame.
+        void digest(bool drain = faux)
+        {
+            auto start = datetime::now();
+            auto thaw = std::function<void()>{}; // Called outside the inbox lock: resuming waits for the running reactor handler, which may be waiting for the inbox lock.
+            while (true)
+            {
+                auto batch = text{};
+                auto image = faux; // The batch is a part of the sixel payload.
+                {
+                    auto guard = std::lock_guard{ inbox.mutex };
+                    auto crop = view{};
+                    if (sixels.active || sixel_begin()) // Decode sixels as they arrive instead of waiting for the whole DCS.
+                    {
+                        crop = sixel_t::ready(view{ inbox.block }.substr(0, inbox_chunk));
+                        if (crop.empty() && inbox.block.size() > inbox_chunk) // A single numeric parameter run longer than the chunk.
+                        {
+                            crop = sixel_t::ready(inbox.block);
+                        }
+                        image = true;
+                    }
+                    else
+                    {
+                        crop = ansi::purify(view{ inbox.block }.substr(0, inbox_chunk));
+                        if (crop.empty() && inbox.block.size() > inbox_chunk) // A long incomplete sequence at the chunk boundary.
+                        {
+                            crop = ansi::purify(inbox.block);
+                        }
+                    }
+                    if (crop.empty()) // Nothing complete to parse.
+                    {
+                        inbox.await = faux;
+                        thaw = std::exchange(inbox.thaw, {}); // The rest of the sequence is still to be read.
+                        break;
+                    }
+                    if (!drain && datetime::now() - start > inbox_quota) // Let other terminals and the renderer proceed.
+                    {
+                        base::enqueue([&](auto& /*boss*/){ digest(); });
+                        break;
+                    }
+                    batch = crop;
+                    inbox.block.erase(0, crop.size());
+                    if (inbox.thaw && inbox.block.size() <= inbox_limit) thaw = std::exchange(inbox.thaw, {});
+                }
+                inbox.synch.notify_one();
+                if (thaw) std::exchange(thaw, {})();
+                if (image) update([&]
+                {
+                    auto data = qiew{ batch };
+                    sixels.decode(data);
+                    return !sixels.active; // The image is shown on ST.
+                });
+                else ondata(batch);
+            }
+            if (thaw) thaw();
+        }
+        // term: Start decoding the sixel image at the head of the inbox (called under the inbox lock).
+        bool sixel_begin()
+        {
+            auto data = qiew{ inbox.block };
+            if (!data.starts_with("\x1bP")) return faux;
+            data.remove_prefix(2);
+            auto stop = data.find_first_not_of("0123456789;");
+            if (stop == view::npos || data[stop] != 'q') return faux; // Not a sixel or the introducer is incomplete.
+            auto params = std::to_array({ -1, -1, -1, -1, -1, -1 });
+            term::read_params(data, params);
+            if (!data.starts_with("q")) return faux;
+            data.remove_prefix(1); // Pop 'q'.
+            if (io_log) log("%%Sixel stream:\n\tparams: %%;%%;%%", prompt::term, params[0], params[1], params[2]);
+            target->parser::flush();
+            sixels.start(params);
+            inbox.block.erase(0, inbox.block.size() - data.size());
+            return true;
+        }
         // term: Reset to defaults.
         void setdef()
         {
@@ -10129,6 +10401,7 @@ namespace netxs::ui
             {
                 ipccon.payoff(io_log);
                 auto lock = bell::sync();
+                digest(true); // Parse the rest of the output before the exit message.
                 auto error = [&]
                 {
                     auto byemsg = escx{};
@@ -11516,14 +11789,26 @@ namespace netxs::ui
         {
             static constexpr auto no_signal = "NO SIGNAL"sv;
         };
+        struct inbox_t
+        {
+            std::mutex            mutex; // inbox_t: Access mutex.
+            text                  block; // inbox_t: Frames received in the reactor thread that have not been handled yet.
+            bool                  await{}; // inbox_t: Handling is scheduled.
+            std::function<void()> thaw; // inbox_t: Resume the reactor reading paused on the backlog limit.
+        };
 
         using vtty = os::dtvt::vtty;
 
+        static constexpr auto inbox_limit = 16 * os::pipebuf; // dtvt: Backlog size at which the reactor stops reading the link.
+
         link stream; // dtvt: Event handler.
         flag active; // dtvt: Terminal lifetime.
         si32 opaque; // dtvt: Object transparency on d_n_d (no pro::cache).
         si32 nodata; // dtvt: Show splash "No signal".
         si32 digest; // dtvt: Bitmap's update serial number.
+        bool packed; // dtvt: Negotiate the compressed stream with the application (for slow remote links).
+        bool poller; // dtvt: Serve the link in the shared epoll thread (Linux only).
+        inbox_t inbox; // dtvt: Frames passed from the shared epoll thread to the task queue.
         face splash; // dtvt: "No signal" splash.
         page errmsg; // dtvt: Overlay error message.
         vtty ipccon; // dtvt: IPC connector. Should be destroyed first.
@@ -11544,6 +11829,47 @@ namespace netxs::ui
         {
             ipccon.output(data);
         }
+        // dtvt: Handle the received frames.
+        void receive(view utf8)
+        {
+            if (active)
+            {
+                stream.sync(utf8);
+                stream.request_jgc(*this);
+                stream.request_images(*this);
+            }
+        }
+        // dtvt: Queue the frames received in the shared epoll thread and schedule their handling on the task queue.
+        //       The handlers take the UI lock, and the shared thread must not wait for it.
+        //       Return faux if the backlog is over the limit: the reader should stop reading until resume() is called.
+        bool ingest(view frames, std::function<void()> resume)
+        {
+            auto guard = std::lock_guard{ inbox.mutex };
+            inbox.block += frames;
+            if (!std::exchange(inbox.await, true))
+            {
+                base::enqueue<faux>([&](auto& /*boss*/){ handover(); }); // The handlers lock what they need.
+            }
+            if (inbox.block.size() <= inbox_limit) return true;
+            inbox.thaw = std::move(resume);
+            return faux;
+        }
+        // dtvt: Handle the queued frames and reschedule the frames queued meanwhile.
+        void handover()
+        {
+            auto batch = text{};
+            auto thaw = std::function<void()>{};
+            {
+                auto guard = std::lock_guard{ inbox.mutex };
+                std::swap(batch, inbox.block);
+                thaw = std::exchange(inbox.thaw, {});
+            }
+            if (thaw) thaw(); // Called outside the inbox lock: resuming waits for the running reactor handler, which may be waiting for the inbox lock.
+            receive(batch);
+            auto guard = std::lock_guard{ inbox.mutex };
+            if (inbox.block.empty()) inbox.await = faux;
+            else                     base::enqueue<faux>([&](auto& /*boss*/){ handover(); }); // Let other objects proceed.
+        }
         // dtvt: Attach a new process.
         template<class T = noop>
         void start_dtvt(eccc& appcfg, T connect_fx = {})
@@ -11552,6 +11878,9 @@ namespace netxs::ui
             {
                 active.exchange(faux); // Do not show "Disconnected".
                 ipccon.payoff();
+                auto guard = std::lock_guard{ inbox.mutex };
+                inbox.block.clear(); // Drop the frames of the previous link.
+                inbox.thaw = {};
             }
             errmsg = genmsg(msgs::no_signal);
             nodata = {};
@@ -11559,12 +11888,11 @@ namespace netxs::ui
             active.exchange(true);
             auto receiver_fx = [&](view utf8)
             {
-                if (active)
-                {
-                    stream.sync(utf8);
-                    stream.request_jgc(*this);
-                    stream.request_images(*this);
-                }
+                receive(utf8);
+            };
+            auto ingest_fx = [&](view frames, std::function<void()> resume)
+            {
+                return ingest(frames, std::move(resume));
             };
             auto shutdown_fx = [&]()
             {
@@ -11577,7 +11905,10 @@ namespace netxs::ui
                     }
                 });
             };
-            ipccon.run_dtvt_app(appcfg, base::size(), connect_fx, receiver_fx, shutdown_fx);
+            auto extensions = directvt::binary::feature::runs | (packed ? directvt::binary::feature::packed : 0u);
+            stream.features.send(*this, extensions); // Queued right after the handshake config. An application that does not support the extensions ignores the frame.
+            ipccon.reactor = poller;
+            ipccon.run_dtvt_app(appcfg, base::size(), connect_fx, receiver_fx, ingest_fx, shutdown_fx);
         }
         // dtvt: Drop removed image metadata from canvas.
         void remove_image_bits(std::bitset<65536> const& touched_images)
@@ -11704,7 +12035,9 @@ namespace netxs::ui
               active{ true },
               opaque{ 0xFF },
               nodata{      },
-              digest{ 1    }
+              digest{ 1    },
+              packed{ faux },
+              poller{ faux }
         {
             auto& accesslock_gears = base::property("applet.accesslock_gears", e2::form::state::keybd::enlist.param());
             LISTEN(tier::release, input::events::device::mouse::any, gear)
@@ -725,6 +725,24 @@ namespace netxs::utf
             }
         }
     }
+    // utf: Return the end of the leading run of printable ASCII chars (0x20-0x7E).
+    auto plain_run(auto head, auto tail)
+    {
+        #if defined(VTM_SIMD_SSE2)
+        auto low = _mm_set1_epi8(0x1F);
+        auto del = _mm_set1_epi8(0x7F);
+        while (tail - head >= 16)
+        {
+            auto v = _mm_loadu_si128((__m128i const*)&*head);
+            auto m = _mm_andnot_si128(_mm_cmpeq_epi8(v, del), _mm_cmpgt_epi8(v, low)); // The signed comparison also rejects 0x80-0xFF.
+            auto bits = (ui32)_mm_movemask_epi8(m);
+            if (bits != 0xFFFF) return head + std::countr_one(bits);
+            head += 16;
+        }
+        #endif
+        while (head != tail && (byte)*head >= 0x20 && (byte)*head < 0x7f) ++head;
+        return head;
+    }
     // utf: Break the text into the grapheme clusters.
     //      Forward the result using the callable "serve" and "yield".
     //      serve: Processes controls and returns the rest of the utf8.
@@ -963,8 +981,7 @@ namespace netxs::utf
                         auto head = rest.begin();
                         auto iter = head;
                         auto tail = rest.end();
-                        while (++iter != tail && is_plain(*iter))
-                        { }
+                        iter = utf::plain_run(iter + 1, tail);
                         auto plain = view{ head, iter };
                         if (iter == tail)
                         {
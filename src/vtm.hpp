@@ -559,6 +559,47 @@ namespace netxs::app::vtm
             bool highlighted = faux;
             bool active = faux;
             tone color = { tone::brighter, tone::shadower };
+            face layer; // window: Window render shared between all attached users.
+            bool cached = faux; // window: The shared render is up to date.
+            bool opaque = faux; // window: The shared render has no transparent cells.
+            ui64 stamp = 0; // window: Shared render version.
+
+            // window: Rebuild the shared window render if the window is damaged. Return faux if the window should be rendered in place.
+            auto refresh()
+            {
+                if (!cached || base::ruined() || layer.size() != base::size())
+                {
+                    auto backdrop = faux;
+                    base::broadcast(tier::request, e2::form::prop::ui::acryl, backdrop);
+                    if (backdrop) // The acrylic effect is based on the actual background of each user.
+                    {
+                        cached = faux;
+                        opaque = faux;
+                        return faux;
+                    }
+                    layer.link(bell::id);
+                    layer.size(base::size());
+                    layer.wipe();
+                    base::ruined(faux);
+                    base::signal(tier::release, e2::render::background::prerender, layer);
+                    base::signal(tier::release, e2::postrender, layer);
+                    opaque = !layer.get_image_sixel() && std::ranges::all_of(layer.pick(), [](auto& c){ return c.bga() == 0xFF; });
+                    cached = true;
+                    stamp++;
+                }
+                return true;
+            }
+            // window: Put the shared window render onto the canvas within its clipping rectangle.
+            void compose(face& parent_canvas)
+            {
+                if (auto context2D = parent_canvas.change_basis(base::region))
+                {
+                    auto full = parent_canvas.full();
+                    layer.move(full.coor);
+                    netxs::onclip(parent_canvas, layer, cell::shaders::overlay);
+                    layer.move(dot_00);
+                }
+            }
 
             void window_swarp(dent warp)
             {
@@ -1000,11 +1041,36 @@ namespace netxs::app::vtm
             }
         };
 
+        // hall: Desktop composed for a single user (compositor mode).
+        struct scene_t
+        {
+            struct shot
+            {
+                ui64 stamp; // shot: Window render version.
+                rect region; // shot: Window region.
+                si32 order; // shot: Window position in the stacking order.
+                bool shown; // shot: The window was composed (it is inside the viewport and is not covered by opaque windows).
+                bool fasten; // shot: The window is out of view and has a navigation string.
+                bool active; // shot: The navigation string is highlighted.
+            };
+
+            core under; // scene: Canvas content before the desktop composition (the gate background).
+            core image; // scene: Canvas content after the desktop composition.
+            rect view; // scene: Viewport of the composed desktop.
+            ui64 epoch = 0; // scene: Version of the hall overlays.
+            std::vector<rect> gates; // scene: Areas of the user gates (user shadows and names).
+            std::unordered_map<id_t, shot> shots; // scene: State of the windows at the last composition.
+        };
+
         std::list<std::pair<sptr, para>> users; // hall: Desktop users.
         netxs::generics::pool async; // hall: Thread pool for parallel task execution.
         pro::maker& maker; // hall: Window creator using drag and drop (right drag).
         pro::robot& robot; // hall: Animation controller.
         std::map<si32, ui::page> hall_overlays; // hall: User defined overlays (for Lua scripting output).
+        ui64 hall_overlays_epoch = 0; // hall: Version of the hall overlays.
+        std::unordered_map<id_t, scene_t> scenes; // hall: Composed desktops of the users (compositor mode).
+        std::vector<window_t*> zstack; // hall: Windows in the stacking order, bottom to top (compositor mode).
+        std::vector<rect> occluders; // hall: Regions of the opaque windows above the current one (compositor mode).
 
         netxs::ui::sptr app_model_ptr = ptr::shared<ui::base>(ui::tui_domain());
         netxs::sptr<desk::usrs> usrs_list_ptr = ptr::shared<desk::usrs>();
@@ -1183,8 +1249,11 @@ namespace netxs::app::vtm
             auto& grade = skin::grade(is_active ? color.active
                                                 : color.passive);
             auto obj_id = object_ptr->id;
+            auto clip = canvas.clip();
+            clip.coor -= window.coor;
             auto pset = [&](twod p, si32 k)
             {
+                if (!clip.hittest(p)) return;
                 //canvas[p].fuse(grade[k], obj_id, p - offset);
                 //canvas[p].fuse(grade[k], obj_id);
                 auto g = grade[k & 0xFF].bgc();
@@ -1196,6 +1265,153 @@ namespace netxs::app::vtm
             window.coor = dot_00;
             netxs::online(window, origin, center, pset);
         }
+        // hall: Draw the background overlays and the gates of other users.
+        void draw_backdrop(face& parent_canvas)
+        {
+            for (auto iter = hall_overlays.begin(); iter != hall_overlays.end() && iter->first < 0; ++iter) // Draw background (index < 0) overlays.
+            {
+                parent_canvas.cup(dot_00);
+                parent_canvas.output(iter->second, cell::shaders::fuse);
+            }
+            if (users.size() > 1) // Draw users.
+            {
+                static auto color = tone{ tone::brighter, tone::shadower };
+                for (auto& [user_ptr, uname] : users)
+                {
+                    fasten(user_ptr, faux, 0, color, parent_canvas); // Draw strings.
+                    if (user_ptr->id != parent_canvas.link()) // Draw a shadow of user's gate for other users.
+                    {
+                        auto gate_area = user_ptr->area();
+                        if (parent_canvas.cmode != svga::vt16 && parent_canvas.cmode != svga::nt16) // Don't show shadow in poor color environment.
+                        {
+                            auto mark = skin::color(tone::shadower);
+                            mark.bga(mark.bga() / 2);
+                            parent_canvas.fill(gate_area.trim(parent_canvas.clip()), [&](cell& c){ c.blend(mark); });
+                        }
+                        gate_area.coor -= dot_01 + parent_canvas.coor();
+                        parent_canvas.output(uname, gate_area.coor, cell::shaders::contrast);
+                    }
+                }
+            }
+        }
+        // hall: Compose the desktop from the shared window renders (compositor mode).
+        //       The previous composition of the user is kept, and only the screen areas of the windows that have been
+        //       changed, moved, raised, opened or closed since then are redrawn (the composition is clipped to them).
+        void compose(face& parent_canvas)
+        {
+            if (scenes.size() > users.size()) // Drop the scenes of disconnected users.
+            {
+                std::erase_if(scenes, [&](auto& rec){ return std::ranges::none_of(users, [&](auto& user){ return user.first->id == rec.first; }); });
+            }
+            auto viewport = parent_canvas.area();
+            auto& scene = scenes[parent_canvas.link()];
+            auto& cells = parent_canvas.pick();
+            auto whole = scene.view != viewport || scene.epoch != hall_overlays_epoch;
+            if (scene.under.size() != viewport.size || cell::equal_run(cells.data(), scene.under.pick().data(), cells.size()) != cells.size()) // The gate background has changed.
+            {
+                parent_canvas.copy(scene.under);
+                whole = true;
+            }
+            auto gates = std::vector<rect>{};
+            if (users.size() > 1) for (auto& [user_ptr, uname] : users) gates.push_back(user_ptr->area());
+            if (gates != scene.gates)
+            {
+                std::swap(gates, scene.gates);
+                whole = true;
+            }
+
+            auto damage = regs{};
+            auto strike = [&](rect region)
+            {
+                if (auto r = viewport.trim(region)) damage.push_back(r);
+            };
+            auto shots = std::unordered_map<id_t, scene_t::shot>{};
+            shots.reserve(zstack.size());
+            for (auto i = (si32)zstack.size() - 1; i >= 0; i--) // Refresh from top to bottom and skip windows covered by opaque ones. Skipped windows stay damaged.
+            {
+                auto& window = *zstack[i];
+                auto& region = window.base::region;
+                auto shown = !window.base::hidden && viewport.trim(region) && std::ranges::none_of(occluders, [&](auto& r){ return r.trim(region) == region; });
+                if (shown && window.refresh() && window.opaque) occluders.push_back(region);
+                if (!shown) zstack[i] = nullptr;
+                auto next = scene_t::shot{ .stamp  = window.stamp,
+                                           .region = region,
+                                           .order  = i,
+                                           .shown  = shown,
+                                           .fasten = !window.base::hidden && !viewport.hittest(region.center()),
+                                           .active = window.highlighted || window.active };
+                if (auto iter = scene.shots.find(window.id); iter != scene.shots.end())
+                {
+                    auto& prev = iter->second;
+                    if (prev.fasten != next.fasten || (next.fasten && (prev.region != next.region || prev.active != next.active))) whole = true; // Navigation strings cross the whole viewport.
+                    if (prev.shown != next.shown || (shown && (!window.cached || prev.stamp != next.stamp || prev.region != next.region || prev.order != next.order)))
+                    {
+                        if (prev.shown) strike(prev.region);
+                        if (next.shown) strike(next.region);
+                    }
+                    scene.shots.erase(iter);
+                }
+                else
+                {
+                    if (next.fasten) whole = true;
+                    if (next.shown) strike(next.region);
+                }
+                shots.emplace(window.id, next);
+            }
+            occluders.clear();
+            for (auto& [window_id, prev] : scene.shots) // Closed windows.
+            {
+                if (prev.fasten) whole = true;
+                if (prev.shown) strike(prev.region);
+            }
+            std::swap(scene.shots, shots);
+
+            auto draw = [&]
+            {
+                draw_backdrop(parent_canvas);
+                for (auto& item_ptr : base::subset)
+                {
+                    auto window_ptr = std::static_pointer_cast<window_t>(item_ptr);
+                    fasten(window_ptr, window_ptr->highlighted, window_ptr->active, window_ptr->color, parent_canvas);
+                }
+                for (auto window_ptr : zstack)
+                {
+                    if (!window_ptr) continue;
+                    if (window_ptr->cached) window_ptr->compose(parent_canvas);
+                    else                    window_ptr->base::render<true>(parent_canvas);
+                }
+            };
+            auto cover = 0ll;
+            for (auto& r : damage) cover += (si64)r.size.x * r.size.y;
+            if (cover * 2 > (si64)viewport.size.x * viewport.size.y) whole = true; // Most of the viewport has changed.
+            if (whole)
+            {
+                draw();
+                parent_canvas.copy(scene.image);
+                scene.view = viewport;
+                scene.epoch = hall_overlays_epoch;
+            }
+            else
+            {
+                if (damage.size() > 8) // Keep the number of clipped passes low.
+                {
+                    auto area = damage.front();
+                    for (auto& r : damage) area |= r;
+                    damage.assign(1, area);
+                }
+                cells = scene.image.pick(); // Restore the previous composition.
+                auto local = regs{};
+                for (auto r : damage)
+                {
+                    local.assign(1, rect{ r.coor - viewport.coor, r.size });
+                    parent_canvas.copy(std::as_const(scene.under), local); // Start from the gate background.
+                    parent_canvas.clip(r);
+                    draw();
+                    scene.image.copy(std::as_const(parent_canvas), local);
+                }
+                parent_canvas.clip(viewport);
+            }
+        }
         auto focus_next_window(hids& gear, si32 dir)
         {
             auto go_forward = dir > 0;
@@ -1298,6 +1514,7 @@ namespace netxs::app::vtm
                                             auto overlay_index = luafx.get_args_or(1, 0);
                                             auto overlay_thing = luafx.get_args_or(2, ""s);
                                             auto iter = hall_overlays.find(overlay_index);
+                                            hall_overlays_epoch++;
                                             if (overlay_thing.empty()) // Drop overlay.
                                             {
                                                 if (iter != hall_overlays.end())
@@ -1903,62 +2120,61 @@ namespace netxs::app::vtm
                 }
             };
             auto& layers = base::field<std::array<std::vector<sptr>, 3>>();
+            auto& compositor = base::field(ui::skin::globals().compositor);
             LISTEN(tier::release, e2::render::any, parent_canvas)
             {
                 auto clip = parent_canvas.clip();         // Draw world without clipping. Wolrd has no size.
                 parent_canvas.clip(parent_canvas.area()); //
 
-                auto overlay_iter = hall_overlays.begin();
-                while (overlay_iter != hall_overlays.end() && overlay_iter->first < 0) // Draw background (index < 0) overlays.
+                auto zlayer = [](auto& window_ptr)
                 {
-                    parent_canvas.cup(dot_00);
-                    parent_canvas.output(overlay_iter->second, cell::shaders::fuse);
-                    overlay_iter++;
-                }
-
-                if (users.size() > 1) // Draw users.
+                    auto zorder = window_ptr->zorder;
+                    return zorder == zpos::plain   ? 1 :
+                           zorder == zpos::topmost ? 2 : 0;
+                };
+                if (compositor && base::subset.size()) // Compose the shared window renders and redraw only the damaged areas.
                 {
-                    static auto color = tone{ tone::brighter, tone::shadower };
-                    for (auto& [user_ptr, uname] : users)
+                    for (auto& item_ptr : base::subset)
+                    {
+                        auto window_ptr = std::static_pointer_cast<window_t>(item_ptr);
+                        layers[zlayer(window_ptr)].push_back(item_ptr);
+                    }
+                    for (auto& layer : layers)
                     {
-                        fasten(user_ptr, faux, 0, color, parent_canvas); // Draw strings.
-                        if (user_ptr->id != parent_canvas.link()) // Draw a shadow of user's gate for other users.
+                        for (auto& item_ptr : layer)
                         {
-                            auto gate_area = user_ptr->area();
-                            if (parent_canvas.cmode != svga::vt16 && parent_canvas.cmode != svga::nt16) // Don't show shadow in poor color environment.
-                            {
-                                auto mark = skin::color(tone::shadower);
-                                mark.bga(mark.bga() / 2);
-                                parent_canvas.fill(gate_area, [&](cell& c){ c.blend(mark); });
-                            }
-                            gate_area.coor -= dot_01 + parent_canvas.coor();
-                            parent_canvas.output(uname, gate_area.coor, cell::shaders::contrast);
+                            zstack.push_back(&static_cast<window_t&>(*item_ptr));
                         }
+                        layer.clear();
                     }
+                    compose(parent_canvas);
+                    zstack.clear();
                 }
-                if (base::subset.size()) // Draw windows.
+                else
                 {
-                    for (auto& item_ptr : base::subset)
+                    draw_backdrop(parent_canvas);
+                    if (base::subset.size()) // Draw windows.
                     {
-                        if (auto window_ptr = std::static_pointer_cast<window_t>(item_ptr))
+                        for (auto& item_ptr : base::subset)
                         {
-                            fasten(window_ptr, window_ptr->highlighted, window_ptr->active, window_ptr->color, parent_canvas);
-                            auto zorder = window_ptr->zorder;
-                            auto i = zorder == zpos::plain   ? 1 :
-                                     zorder == zpos::topmost ? 2 : 0;
-                            layers[i].push_back(item_ptr);
+                            if (auto window_ptr = std::static_pointer_cast<window_t>(item_ptr))
+                            {
+                                fasten(window_ptr, window_ptr->highlighted, window_ptr->active, window_ptr->color, parent_canvas);
+                                layers[zlayer(window_ptr)].push_back(item_ptr);
+                            }
                         }
-                    }
-                    //todo implement access lock visualization?
-                    for (auto& layer : layers)
-                    {
-                        for (auto& item_ptr : layer)
+                        //todo implement access lock visualization?
+                        for (auto& layer : layers)
                         {
-                            item_ptr->render<true>(parent_canvas);
+                            for (auto& item_ptr : layer)
+                            {
+                                item_ptr->render<true>(parent_canvas);
+                            }
+                            layer.clear();
                         }
-                        layer.clear();
                     }
                 }
+                auto overlay_iter = hall_overlays.lower_bound(0);
                 while (overlay_iter != hall_overlays.end()) // Draw foreground (index >= 0) overlays.
                 {
                     parent_canvas.cup(dot_00);
@@ -0,0 +1,60 @@
+// Copyright (c) Dmitry Sapozhnikov
+// Licensed under the MIT license.
+
+// Double box blur of the cell backgrounds on a 240x70 screen for radii 1-8: the column-by-column netxs::boxblur
+// compared to face::blur (misc::boxblur_bgc: row-by-row vertical pass with the SSE2/AVX2 irgb kernels), for the full
+// screen and for a partial damage (a 20x3 block changed per frame, face::blur with blur_memo).
+
+#include "netxs/desktopio/richtext.hpp"
+#include "testing.hpp"
+
+using namespace netxs;
+using namespace netxs::testing;
+
+void column_by_column(ui::face& canvas, si32 r, vrgb& cache) // netxs::boxblur as used by face::blur before.
+{
+    using irgb = vrgb::value_type;
+    auto area = canvas.area();
+    auto clip = canvas.clip();
+    cache.resize((size_t)clip.size.x * clip.size.y);
+    auto s_point = [](auto c)->auto& { return c->bgc(); };
+    auto d_point = [](auto c)->auto& { return *c;       };
+    for (auto _(2); _--;)
+    netxs::boxblur<irgb>(canvas.begin(clip.coor - area.coor), cache.begin(), clip.size.x, clip.size.y, r, area.size.x, clip.size.x, 2, s_point, d_point);
+}
+
+int main()
+{
+    static constexpr auto size = twod{ 240, 70 };
+    auto source = ui::face{};
+    source.size(size);
+    for (auto& c : source) c.bgc(argb{ (ui32)random<ui32>(0, 0xFFFFFFFF) });
+    auto canvas = ui::face{};
+    canvas.size(size);
+    auto cache = vrgb{};
+    auto reset = [&]{ std::copy(source.begin(), source.end(), canvas.begin()); };
+    std::printf("Double box blur of a %dx%d screen, avx2: %s\n", size.x, size.y, netxs::cpu_avx2() ? "yes" : "no");
+    std::printf("  %6s %14s %14s %8s %18s\n", "radius", "columns us", "rows us", "speedup", "rows damage us");
+    for (auto r = 1; r <= 8; r++)
+    {
+        auto columns_ns = measure(100, [&]{ reset(); column_by_column(canvas, r, cache); });
+        auto rows_ns    = measure(100, [&]{ reset(); canvas.blur(r, cache); });
+        auto reset_ns   = measure(100, [&]{ reset(); sink(canvas); });
+        auto memo = ui::blur_memo{};
+        auto frame = 0;
+        auto damage_ns = measure(100, [&]
+        {
+            reset();
+            auto y = 5 + frame++ % (size.y - 10);
+            for (auto& c : std::span{ canvas.begin() + y * size.x + 100, 20 }) c.bgc(argb{ 0xFF000000 | (ui32)frame });
+            for (auto& c : std::span{ canvas.begin() + (y + 1) * size.x + 100, 20 }) c.bgc(argb{ 0xFF000000 | (ui32)frame });
+            for (auto& c : std::span{ canvas.begin() + (y + 2) * size.x + 100, 20 }) c.bgc(argb{ 0xFF000000 | (ui32)frame });
+            canvas.blur(r, memo, cache);
+        });
+        columns_ns -= reset_ns;
+        rows_ns -= reset_ns;
+        damage_ns -= reset_ns;
+        std::printf("  %6d %14.1f %14.1f %7.2fx %18.1f\n", r, columns_ns / 1e3, rows_ns / 1e3, columns_ns / rows_ns, damage_ns / 1e3);
+    }
+    return 0;
+}
@@ -0,0 +1,86 @@
+// Copyright (c) Dmitry Sapozhnikov
+// Licensed under the MIT license.
+
+// DirectVT frame reading over a pipe loopback (a writer thread and os::ipc::stdcon on the reading end): the former
+// reading loop (appending every read to a text buffer and erasing the processed prefix) compared to stream::reading_loop
+// (whole frames in place, only a split frame carried over and received directly), for small, medium and large frames.
+
+#include "netxs/desktopio/console.hpp"
+#include "netxs/desktopio/system.hpp"
+#include "testing.hpp"
+
+using namespace netxs;
+using namespace netxs::testing;
+
+using stream = directvt::binary::stream;
+
+template<class T, class P>
+void legacy_loop(T& link, P&& proc) // The reading loop before the carry buffer.
+{
+    auto flow = text{};
+    while (link)
+    {
+        auto shot = link.recv();
+        if (shot && link)
+        {
+            flow += shot;
+            if (auto crop = stream::purify(flow))
+            {
+                proc(crop);
+                flow.erase(0, crop.size());
+            }
+        }
+        else break;
+    }
+}
+
+auto make_frames(size_t frame_size, size_t total)
+{
+    auto block = text{};
+    while (block.size() < total)
+    {
+        auto size = netxs::letoh((sz_t)frame_size);
+        block.append((char const*)&size, sizeof(size));
+        block.append(frame_size - sizeof(size), (char)random('!', '~'));
+    }
+    return block;
+}
+auto loopback(view block, bool legacy)
+{
+    auto [r, w] = os::ipc::newpipe();
+    auto link = os::ipc::stdcon{ r, os::invalid_fd };
+    auto bytes = 0_sz;
+    auto writer = std::thread{ [&, w = w]
+    {
+        for (auto step = 64_sz << 10; block.size(); block.remove_prefix(std::min(step, block.size())))
+        {
+            os::io::send(w, block.substr(0, std::min(step, block.size())));
+        }
+        os::close(w);
+    }};
+    auto proc = [&](view data){ bytes += data.size(); sink(data); };
+    auto start = datetime::now();
+    if (legacy) legacy_loop(link, proc);
+    else        stream::reading_loop(link, proc);
+    auto spent = datetime::now() - start;
+    writer.join();
+    return std::pair{ bytes, std::chrono::duration<double>(spent).count() };
+}
+
+int main()
+{
+    static constexpr auto total = 256_sz << 20;
+    std::printf("DirectVT frames over a pipe loopback, %zu MiB per run\n", total >> 20);
+    std::printf("  %10s %14s %14s %8s\n", "frame", "legacy MB/s", "reader MB/s", "speedup");
+    for (auto frame_size : { 64_sz, 4_sz << 10, 256_sz << 10, 4_sz << 20 })
+    {
+        auto block = make_frames(frame_size, total);
+        auto [legacy_bytes, legacy_s] = loopback(block, true);
+        auto [reader_bytes, reader_s] = loopback(block, faux);
+        check(legacy_bytes == block.size() && reader_bytes == block.size(), "every frame is received");
+        auto legacy_rate = legacy_bytes / legacy_s / 1e6;
+        auto reader_rate = reader_bytes / reader_s / 1e6;
+        std::printf("  %10zu %14.1f %14.1f %7.2fx\n", frame_size, legacy_rate, reader_rate, reader_rate / legacy_rate);
+    }
+    return result();
+}
@@ -0,0 +1,71 @@
+// Copyright (c) Dmitry Sapozhnikov
+// Licensed under the MIT license.
+
+// Event dispatch cost in events::auth on a tree of 1001 objects (root -> 10 -> 990 leaves):
+// 1000 timer ticks delivered to the 1001 e2::timer::tick subscribers (about 1M handler calls), and
+// 1M e2::conio::mouse events raised from random leaves up to the root, with handlers on the event and on its group.
+
+#include "netxs/apps.hpp"
+#include "testing.hpp"
+
+using namespace netxs;
+using namespace netxs::testing;
+namespace e2 = netxs::events::userland::e2;
+
+int main()
+{
+    auto& indexer = ui::tui_domain();
+    auto lock = indexer.unique_lock();
+    auto calls = 0ll;
+    auto subscribe = [&](auto& boss)
+    {
+        boss.LISTEN(tier::general, e2::timer::tick, now)
+        {
+            calls++;
+            sink(now);
+        };
+        boss.LISTEN(tier::release, e2::conio::mouse, m)
+        {
+            calls++;
+            sink(m);
+        };
+        boss.LISTEN(tier::release, e2::conio::any, m)
+        {
+            calls++;
+            sink(m);
+        };
+        boss.LISTEN(tier::release, e2::form::state::hover, n) // Unrelated subscriptions of the same object.
+        {
+            sink(n);
+        };
+    };
+    auto root = ui::cake::ctor();
+    root->invoke(subscribe);
+    auto leaves = std::vector<netxs::sptr<ui::cake>>{};
+    for (auto i = 0; i < 10; i++)
+    {
+        auto node = root->attach(ui::cake::ctor())->invoke(subscribe);
+        for (auto j = 0; j < 99; j++) leaves.push_back(node->attach(ui::cake::ctor())->invoke(subscribe));
+    }
+
+    static constexpr auto ticks = 1000;
+    calls = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (auto i = 0; i < ticks; i++) indexer.timer(datetime::now());
+    auto tick_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    std::printf("events::auth, %zu objects\n", leaves.size() + 11);
+    std::printf("  timer tick     %8.1f us/tick  %6.1f ns/handler  (%lld handler calls)\n", tick_ns / ticks / 1000, tick_ns / calls, calls);
+
+    static constexpr auto count = 1'000'000;
+    auto picks = std::vector<si32>(count);
+    for (auto& p : picks) p = random(0, (si32)leaves.size() - 1);
+    auto m = input::sysmouse{};
+    calls = 0;
+    start = std::chrono::steady_clock::now();
+    for (auto p : picks) leaves[p]->base::riseup(tier::release, e2::conio::mouse, m, true); // Forced: every level handles it.
+    auto mouse_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    std::printf("  mouse riseup   %8.1f ns/event  %6.1f ns/object   (%lld handler calls)\n", mouse_ns / count, mouse_ns / count / 3, calls);
+    leaves.clear();
+    root.reset();
+    return 0;
+}
@@ -0,0 +1,63 @@
+// Copyright (c) Dmitry Sapozhnikov
+// Licensed under the MIT license.
+
+// Frame diff throughput of binary::bitmap_dtvt_t::set() on a 400x120 canvas for 0%, 1%, 10% and 100% changed frames,
+// and the raw unchanged-cell scan rate of cell::equal_run() compared to the scalar cell::operator ==.
+
+#include "netxs/desktopio/directvt.hpp"
+#include "testing.hpp"
+
+using namespace netxs;
+using namespace netxs::testing;
+
+int main()
+{
+    static constexpr auto size = twod{ 400, 120 };
+    auto frame = core{};
+    frame.size(size, cell{});
+    auto i = 0;
+    for (auto& c : frame)
+    {
+        c.bgc(argb{ (ui32)(0xFF000000 | (i * 2654435761u >> 8)) }).fgc(argb{ 0xFFc0c0c0 }).txt((char)('!' + i % 90));
+        i++;
+    }
+    auto damage = regs{ rect{ dot_00, size } };
+    auto abort = flag{ faux };
+    auto delta = sz_t{};
+    std::printf("bitmap_dtvt_t::set, %dx%d canvas\n", size.x, size.y);
+    for (auto percent : { 0, 1, 10, 100 })
+    {
+        auto next = frame;
+        auto cells = (si32)(next.size().x * next.size().y);
+        auto count = cells * percent / 100;
+        auto step = count ? cells / count : 0;
+        for (auto n = 0; n < count; n++)
+        {
+            auto& c = *(next.begin() + n * step);
+            c.bgc(argb{ c.bgc().token ^ 0x00FFFFFF });
+        }
+        auto bitmap = directvt::binary::bitmap_dtvt_t{};
+        bitmap.set(1, dot_00, frame, damage, abort, delta); // Initial full frame.
+        auto flip = faux;
+        auto ns = measure(200, [&]
+        {
+            bitmap.set(1, dot_00, (flip = !flip) ? next : frame, damage, abort, delta);
+        });
+        std::printf("  %3d%% changed: %8.1f Mcells/s, %6.1f us/frame, %7u bytes/frame\n", percent, cells / ns * 1000.0, ns / 1000.0, (unsigned)delta);
+    }
+    auto prev = frame;
+    auto cells = (size_t)size.x * size.y;
+    auto simd_ns = measure(2000, [&]
+    {
+        sink(cell::equal_run(&*frame.begin(), &*prev.begin(), cells));
+    });
+    auto plain_ns = measure(2000, [&]
+    {
+        auto a = &*frame.begin();
+        auto b = &*prev.begin();
+        auto n = 0_sz;
+        while (n < cells && a[n] == b[n]) n++;
+        sink(n);
+    });
+    std::printf("unchanged-cell scan: equal_run %.1f Mcells/s, operator == %.1f Mcells/s\n", cells / simd_ns * 1000.0, cells / plain_ns * 1000.0);
+}
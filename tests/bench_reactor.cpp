@@ -0,0 +1,122 @@
+// Copyright (c) Dmitry Sapozhnikov
+// Licensed under the MIT license.
+
+// DirectVT link reading on Linux: a blocking reading thread per link (stream::reading_loop) compared to the shared
+// epoll thread (os::io::reactor with stream::reader). N links over pipes, idle (CPU time spent in one second)
+// and busy (400 frames of 512 bytes written to every link); the thread count and the context switches are reported.
+
+#include "netxs/desktopio/console.hpp"
+#include "netxs/desktopio/system.hpp"
+#include "testing.hpp"
+
+#include <sys/resource.h>
+
+using namespace netxs;
+using namespace netxs::testing;
+
+#if defined(__linux__)
+
+auto threads()
+{
+    auto file = std::ifstream{ "/proc/self/status" };
+    auto line = std::string{};
+    while (std::getline(file, line)) if (line.starts_with("Threads:")) return std::stoi(line.substr(8));
+    return 0;
+}
+auto usage()
+{
+    auto info = ::rusage{};
+    ::getrusage(RUSAGE_SELF, &info);
+    auto cpu = (info.ru_utime.tv_sec + info.ru_stime.tv_sec) * 1'000'000ll + info.ru_utime.tv_usec + info.ru_stime.tv_usec;
+    return std::pair{ cpu, (si64)(info.ru_nvcsw + info.ru_nivcsw) };
+}
+
+struct links
+{
+    static constexpr auto frame_size = 512;
+    static constexpr auto frame_count = 400;
+
+    bool                                      shared;
+    std::vector<netxs::sptr<os::ipc::stdcon>> ends; // Reading ends.
+    std::vector<os::fd_t>                     pens; // Writing ends.
+    std::vector<std::thread>                  agents;
+    std::vector<ui64>                         watches;
+    std::atomic<si64>                         bytes{}; // Received frame bytes.
+
+    links(si32 count, bool shared)
+        : shared{ shared }
+    {
+        for (auto i = 0; i < count; i++)
+        {
+            auto [r, w] = os::ipc::newpipe();
+            auto& link = *ends.emplace_back(ptr::shared<os::ipc::stdcon>(r, os::invalid_fd));
+            pens.push_back(w);
+            auto proc = [&](view data){ bytes += data.size(); sink(data); }; // Whole frames received at once are passed together.
+            if (shared) watches.push_back(os::io::reactor::attach(r, [&link, proc, reader = directvt::binary::stream::reader{}]() mutable
+            {
+                return reader.step(link, proc);
+            }));
+            else agents.emplace_back([&link, proc]{ directvt::binary::stream::reading_loop(link, proc); });
+        }
+    }
+   ~links()
+    {
+        for (auto& w : pens) os::close(w); // EOF ends the reading.
+        for (auto& t : agents) t.join();
+        for (auto token : watches) os::io::reactor::detach(token);
+    }
+    void write()
+    {
+        auto block = text(frame_size, '\0');
+        auto size = netxs::letoh((sz_t)frame_size); // Frame: [size][payload].
+        ::memcpy(block.data(), &size, sizeof(size));
+        for (auto n = 0; n < frame_count; n++)
+        {
+            for (auto w : pens) os::io::send(w, block);
+        }
+        auto total = (si64)frame_count * frame_size * (si64)pens.size();
+        while (bytes < total) std::this_thread::yield();
+    }
+};
+
+int main()
+{
+    auto limit = ::rlimit{};
+    ::getrlimit(RLIMIT_NOFILE, &limit);
+    limit.rlim_cur = limit.rlim_max;
+    ::setrlimit(RLIMIT_NOFILE, &limit);
+    os::io::reactor::global(); // Start the shared thread before counting.
+    std::printf("DirectVT link reading, %d frames of %d bytes per busy link\n", links::frame_count, links::frame_size);
+    std::printf("  %-8s %5s %8s %10s %12s %12s\n", "mode", "links", "threads", "idle us/s", "busy ms", "busy ctxsw");
+    for (auto count : { 10, 100, 400 })
+    {
+        if ((rlim_t)count * 4 + 64 > limit.rlim_cur) break;
+        for (auto shared : { faux, true })
+        {
+            auto bench = links{ count, shared };
+            auto n = threads();
+            auto [idle_cpu, idle_csw] = usage();
+            std::this_thread::sleep_for(1s);
+            auto [busy_cpu, busy_csw] = usage();
+            auto start = datetime::now();
+            bench.write();
+            auto spent = datetime::now() - start;
+            auto [done_cpu, done_csw] = usage();
+            std::printf("  %-8s %5d %8d %10lld %12.1f %12lld\n", shared ? "reactor" : "threads", count, n, busy_cpu - idle_cpu,
+                std::chrono::duration<double, std::milli>(spent).count(), done_csw - busy_csw);
+            (void)idle_csw;
+            (void)done_cpu;
+        }
+    }
+    return 0;
+}
+
+#else
+
+int main()
+{
+    std::printf("os::io::reactor is Linux only\n");
+    return 0;
+}
+
+#endif
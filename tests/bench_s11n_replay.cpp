@@ -0,0 +1,141 @@
+// Copyright (c) Dmitry Sapozhnikov
+// Licensed under the MIT license.
+
+// Replay of a recorded-like DirectVT stream (1M frames in batches of 64: mouse and keyboard events decoded into the
+// typed structs, and opaque bitmap frames of the kinds bitmap_dtvt=38, vtrgb=39, vt256=40, vt16=41, vt_2D=42 passed
+// to boss.direct()) through s11n::sync: the former unordered_map<type, std::function> lookup compared to the s11n::exec
+// table indexed by the frame type, for the mixed stream and for the bitmaps only (the dispatch cost alone).
+
+#include "netxs/desktopio/directvt.hpp"
+#include "testing.hpp"
+
+using namespace netxs;
+using namespace netxs::testing;
+
+namespace binary = directvt::binary;
+using s11n = binary::s11n;
+using type = binary::type;
+
+struct host // Boss with the handlers used by the replayed stream.
+{
+    si64 bytes{}; // host: Bitmap payload bytes.
+    si64 input{}; // host: Decoded input events.
+
+    void direct(s11n::xs::bitmap_dtvt  /*lock*/, view& data) { bytes += data.size(); }
+    void direct(s11n::xs::bitmap_vtrgb /*lock*/, view& data) { bytes += data.size(); }
+    void direct(s11n::xs::bitmap_vt256 /*lock*/, view& data) { bytes += data.size(); }
+    void direct(s11n::xs::bitmap_vt16  /*lock*/, view& data) { bytes += data.size(); }
+    void direct(s11n::xs::bitmap_vt_2D /*lock*/, view& data) { bytes += data.size(); }
+    void handle(s11n::xs::syskeybd lock) { input += lock.thing.virtcod; }
+    void handle(s11n::xs::sysmouse lock) { input += lock.thing.buttons; }
+};
+struct sender
+{
+    text block;
+    void output(view data) { block += data; }
+};
+
+auto record(si32 count, bool bitmaps_only) // Batches of frames as passed by stream::reading_loop.
+{
+    static constexpr type bitmaps[] = { binary::bitmap_dtvt::kind, binary::bitmap_vtrgb::kind, binary::bitmap_vt256::kind,
+                                        binary::bitmap_vt16::kind, binary::bitmap_vt_2D::kind };
+    auto tx = s11n{};
+    auto out = sender{};
+    auto batches = std::vector<text>{};
+    for (auto i = 0; i < count; i++)
+    {
+        auto dice = bitmaps_only ? 0 : random(0, 9);
+        if (dice >= 5)
+        {
+            auto lock = tx.sysmouse.freeze();
+            lock.thing.buttons = random(0, 7);
+            lock.thing.coordxy = { (fp32)random(0, 1920), (fp32)random(0, 1080) };
+            lock.thing.set();
+            lock.thing.sendby(out);
+        }
+        else if (dice >= 3)
+        {
+            auto lock = tx.syskeybd.freeze();
+            lock.thing.virtcod = random(0x20, 0x7E);
+            lock.thing.cluster = text(1, (char)lock.thing.virtcod);
+            lock.thing.set();
+            lock.thing.sendby(out);
+        }
+        else
+        {
+            auto payload = text((size_t)random(16, 256), (char)random('!', '~'));
+            auto size = netxs::letoh((sz_t)(sizeof(sz_t) + sizeof(type) + payload.size()));
+            out.block.append((char const*)&size, sizeof(size));
+            out.block.push_back((char)bitmaps[random(0, 4)]);
+            out.block += payload;
+        }
+        if (i % 64 == 63)
+        {
+            batches.push_back(std::move(out.block));
+            out.block.clear();
+        }
+    }
+    if (out.block.size()) batches.push_back(out.block);
+    return batches;
+}
+auto legacy_table(s11n& rx, host& boss) // The former s11n::exec filling for the replayed kinds.
+{
+    auto exec = std::unordered_map<type, std::function<void(view&)>>{};
+    exec[binary::bitmap_dtvt ::kind] = [&](auto& data){ boss.direct(rx.bitmap_dtvt .freeze(), data); };
+    exec[binary::bitmap_vtrgb::kind] = [&](auto& data){ boss.direct(rx.bitmap_vtrgb.freeze(), data); };
+    exec[binary::bitmap_vt256::kind] = [&](auto& data){ boss.direct(rx.bitmap_vt256.freeze(), data); };
+    exec[binary::bitmap_vt16 ::kind] = [&](auto& data){ boss.direct(rx.bitmap_vt16 .freeze(), data); };
+    exec[binary::bitmap_vt_2D::kind] = [&](auto& data){ boss.direct(rx.bitmap_vt_2D.freeze(), data); };
+    exec[binary::syskeybd::kind] = [&](auto& data){ boss.handle(rx.syskeybd.sync(data)); };
+    exec[binary::sysmouse::kind] = [&](auto& data){ boss.handle(rx.sysmouse.sync(data)); };
+    for (auto kind = 0; kind < (si32)rx.exec.size(); kind++) // The rest of the object kinds (sync only).
+    {
+        if (rx.exec[kind] && !exec.contains((type)kind)) exec[(type)kind] = [&, proc = rx.exec[kind]](auto& data){ proc(rx, &boss, data); };
+    }
+    return exec;
+}
+
+int main()
+{
+    static constexpr auto count = 1 << 20;
+    std::printf("s11n::sync replay, %d frames in batches of 64\n", count);
+    std::printf("  %-14s %14s %14s %8s\n", "stream", "map ns/frame", "table ns/frame", "speedup");
+    for (auto bitmaps_only : { faux, true })
+    {
+        auto batches = record(count, bitmaps_only);
+        auto boss = host{};
+        auto rx = s11n{ boss };
+        auto exec = legacy_table(rx, boss);
+        auto map_replay = [&]
+        {
+            for (auto& batch : batches)
+            {
+                auto data = view{ batch };
+                auto lock = rx.frames.sync(data);
+                for (auto& frame : lock.thing)
+                {
+                    auto iter = exec.find(frame.next);
+                    if (iter != exec.end()) iter->second(frame.data);
+                }
+            }
+        };
+        auto table_replay = [&]
+        {
+            for (auto& batch : batches)
+            {
+                auto data = view{ batch };
+                rx.sync(data);
+            }
+        };
+        map_replay();
+        auto map_result = std::pair{ boss.bytes, boss.input };
+        boss = {};
+        table_replay();
+        check(std::pair{ boss.bytes, boss.input } == map_result, "both replays handle the same frames");
+        auto map_ns   = measure(5, map_replay) / count;
+        auto table_ns = measure(5, table_replay) / count;
+        sink(boss);
+        std::printf("  %-14s %14.2f %14.2f %7.2fx\n", bitmaps_only ? "bitmaps only" : "mixed", map_ns, table_ns, map_ns / table_ns);
+    }
+    return result();
+}
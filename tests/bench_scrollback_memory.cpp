@@ -0,0 +1,75 @@
+// Copyright (c) Dmitry Sapozhnikov
+// Licensed under the MIT license.
+
+// Memory footprint of 100k scrollback lines (120-column colored build-log lines) as plain cells
+// and packed by line::freeze(), plus the cost of packing and unpacking a line.
+// The footprint is the line objects and their heap storage; the process RSS growth is printed alongside where available.
+
+#include "netxs/desktopio/richtext.hpp"
+#include "testing.hpp"
+
+#include <fstream>
+
+using namespace netxs;
+using namespace netxs::testing;
+
+auto resident() // Process resident set size in bytes, zero if unknown.
+{
+    auto pages = 0ull;
+    auto rss = 0ull;
+    #if defined(__linux__)
+    std::ifstream{ "/proc/self/statm" } >> pages >> rss;
+    #endif
+    return rss * 4096;
+}
+auto footprint(std::vector<ui::line> const& lines)
+{
+    auto bytes = lines.capacity() * sizeof(ui::line);
+    for (auto& l : lines) bytes += l.cells.capacity() * sizeof(cell) + (l.frost.capacity() > 15 ? l.frost.capacity() + 1 : 0);
+    return bytes;
+}
+
+int main()
+{
+    static constexpr auto count = 100'000;
+    static constexpr auto width = 120;
+    auto lines = std::vector<ui::line>{};
+    lines.reserve(count);
+    auto rss_0 = resident();
+    for (auto i = 0; i < count; i++)
+    {
+        auto step = "[" + std::to_string(i % 4096) + "/4096] ";
+        auto& l = lines.emplace_back();
+        l.reinitialize(i, ansi::deco{}, cell{}.fgc(argb{ 0xFFc0c0c0 }).bgc(argb{ 0xFF000000 }), 0);
+        auto put = [&](view utf8, argb fgc)
+        {
+            for (auto c : utf8) l.cells.push_back(cell{ l.brush }.fgc(fgc).txt(c));
+        };
+        put(step, argb{ 0xFF00ff00 });
+        put("Building CXX object src/netxs/CMakeFiles/vtm.dir/desktopio/", argb{ 0xFFc0c0c0 });
+        put("terminal.cpp.o", argb{ 0xFFffffff });
+        while (l.cells.size() < width) l.cells.push_back(l.brush); // Trailing blanks up to the terminal width.
+        l.cells.shrink_to_fit();
+    }
+    auto cells_bytes = footprint(lines);
+    auto rss_1 = resident();
+    auto reference = lines[count / 2];
+    auto start = std::chrono::steady_clock::now();
+    for (auto& l : lines) l.freeze();
+    auto pack_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / count;
+    auto packed_bytes = footprint(lines);
+    auto rss_2 = resident();
+    auto probe = lines[count / 2];
+    auto thaw_ns = measure(10000, [&]{ auto l = probe; l.thaw(); sink(l); });
+    probe.thaw();
+    auto same = probe.cells.size() == reference.cells.size() && std::equal(probe.cells.begin(), probe.cells.end(), reference.cells.begin());
+    auto mb = [](auto bytes){ return (double)bytes / (1 << 20); };
+    std::printf("scrollback, %d lines of %d cells, %zu bytes per cell, %zu bytes per line header\n", count, width, sizeof(cell), sizeof(ui::line));
+    std::printf("  cells         %8.1f MB\n", mb(cells_bytes));
+    std::printf("  packed        %8.1f MB  (%.1f%%)\n", mb(packed_bytes), 100.0 * packed_bytes / cells_bytes);
+    if (rss_0) std::printf("  rss growth    %8.1f MB -> %.1f MB after packing\n", mb(rss_1 - rss_0), mb((ptrdiff_t)rss_2 - (ptrdiff_t)rss_0));
+    std::printf("  freeze        %8.0f ns/line\n", pack_ns);
+    std::printf("  thaw          %8.0f ns/line\n", thaw_ns);
+    std::printf("  round trip    %s\n", same ? "identical" : "MISMATCH");
+    return same ? 0 : 1;
+}
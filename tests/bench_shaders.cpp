@@ -0,0 +1,81 @@
+// Copyright (c) Dmitry Sapozhnikov
+// Licensed under the MIT license.
+
+// Cost of the cell::shaders brushes over a full 1920x1080 canvas: the cell canvas (core) via core::fill,
+// and the argb pixel raster via netxs::onrect, where the batched kernels (blend/mix/alpha) are compared
+// with the per-pixel scalar loop they replace.
+
+#include "netxs/desktopio/canvas.hpp"
+#include "testing.hpp"
+
+using namespace netxs;
+using namespace netxs::testing;
+
+int main()
+{
+    static constexpr auto size = twod{ 1920, 1080 };
+    auto total = (double)size.x * size.y;
+    auto canvas = core{};
+    canvas.size(size, cell{});
+    auto i = 0u;
+    for (auto& c : canvas)
+    {
+        c.bgc(argb{ 0x80000000 | i * 2654435761u }).fgc(argb{ 0xFFc0c0c0 }).txt((char)('!' + i % 90));
+        i++;
+    }
+    auto origin = canvas;
+    auto brush = cell{}.bgc(argb{ 0x80204060 }).fgc(argb{ 0x80ffffff }).txt('x');
+    auto report = [&](char const* name, double ns)
+    {
+        std::printf("  %-14s %8.2f ms  %7.1f Mcells/s\n", name, ns / 1e6, total / ns * 1e3);
+    };
+    auto run = [&](char const* name, auto fx)
+    {
+        report(name, measure(10, [&]{ canvas.fill(fx); sink(canvas); }));
+        canvas = origin;
+    };
+    std::printf("cell shaders, %dx%d cells\n", size.x, size.y);
+    run("full",        cell::shaders::full(brush));
+    run("flat",        cell::shaders::flat(brush));
+    run("fuse",        cell::shaders::fuse(brush));
+    run("fusefull",    cell::shaders::fusefull(brush));
+    run("overlay",     cell::shaders::overlay(brush));
+    run("mix",         cell::shaders::mix(brush));
+    run("blend",       cell::shaders::blend(brush));
+    run("lite",        cell::shaders::lite(brush));
+    run("skipnulls",   cell::shaders::skipnulls(brush));
+    run("contrast",    cell::shaders::contrast(brush));
+    run("color",       cell::shaders::color(brush));
+    run("xlucent",     cell::shaders::xlucent(0x80));
+    run("shadow",      cell::shaders::shadow(3));
+    run("invert",      cell::shaders::invert);
+    run("reverse",     cell::shaders::reverse);
+    run("wipe",        cell::shaders::wipe);
+
+    auto pixels = raster<std::vector<argb>>{};
+    pixels.size(size, argb{});
+    pixels.clip(pixels.area());
+    auto j = 0u;
+    for (auto& p : pixels) p = argb{ (j++ * 2654435761u) | 0x01000000 };
+    auto source = pixels._data;
+    auto color = argb{ 0x80204060 };
+    auto area = pixels.area();
+    auto scalar = [&](char const* name, auto fx)
+    {
+        report(name, measure(20, [&]{ for (auto& p : pixels) fx(p); sink(pixels); }));
+        pixels._data = source;
+    };
+    auto batched = [&](char const* name, auto fx)
+    {
+        report(name, measure(20, [&]{ netxs::onrect(pixels, area, fx); sink(pixels); }));
+        pixels._data = source;
+    };
+    std::printf("argb raster shaders, %dx%d pixels\n", size.x, size.y);
+    scalar ("blend scalar", [&](argb& p){ p.mix(color); });
+    batched("blend batched", cell::shaders::blend(color));
+    batched("mix batched",   cell::shaders::mix(color));
+    scalar ("alpha scalar", [&](argb& p){ p.alpha_sum(64); });
+    batched("alpha batched", cell::shaders::alpha(64));
+    batched("full",          cell::shaders::full(color));
+    return 0;
+}
@@ -0,0 +1,79 @@
+// Copyright (c) Dmitry Sapozhnikov
+// Licensed under the MIT license.
+
+// Sixel stream decoding through the term inbox (term::digest -> sixel_t::ready -> sixel_t::decode) on a 200x50 terminal:
+// an 800x480 image with a 256-color palette fed in PTY-sized parts, and an image preceded by more than one parse chunk
+// of palette definitions only (#n;2;r;g;b), which must be decoded to the end instead of stalling the inbox.
+
+#include "netxs/apps.hpp"
+#include "testing.hpp"
+
+using namespace netxs;
+using namespace netxs::testing;
+
+auto make_image(twod size, si32 colors, si32 palette_entries)
+{
+    auto data = text{ "\x1bP0;1;0q\"1;1;" + std::to_string(size.x) + ";" + std::to_string(size.y) };
+    for (auto i = 0; i < palette_entries; i++)
+    {
+        data += "#" + std::to_string(i % 65536) + ";2;" + std::to_string(random(0, 100)) + ";" + std::to_string(random(0, 100)) + ";" + std::to_string(random(0, 100));
+    }
+    for (auto band = 0; band < size.y / 6; band++)
+    {
+        for (auto c = 0; c < colors; c++)
+        {
+            data += "#" + std::to_string(c);
+            for (auto x = 0; x < size.x;)
+            {
+                auto n = random(1, 12);
+                auto s = (char)random('?', '~');
+                if (n > 3) data += "!" + std::to_string(n) + s;
+                else       data += text(n, s);
+                x += n;
+            }
+            data += "$";
+        }
+        data += "-";
+    }
+    data += "\x1b\\";
+    return data;
+}
+
+int main()
+{
+    auto& indexer = ui::tui_domain();
+    auto xmldoc = app::shared::load::settings("");
+    indexer.config.document.swap(xmldoc);
+    app::shared::get_tui_config(indexer.config, ui::skin::globals());
+    auto lock = indexer.unique_lock();
+    auto term = ui::term::ctor();
+    term->base::resize({ 200, 50 });
+
+    auto palette_only = text{};
+    while (palette_only.size() < ui::term::inbox_chunk) palette_only += "#" + std::to_string(random(0, 2047)) + ";2;10;20;30";
+    check(!ui::term::sixel_t::ready(palette_only).empty(), "a palette-only part is cut before its last color introducer");
+
+    auto feed = [&](text const& data)
+    {
+        static constexpr auto chunk = 64_sz << 10; // Typical PTY read size.
+        auto crop = view{ data };
+        while (crop.size())
+        {
+            auto step = std::min(chunk, crop.size());
+            term->inbox.block += crop.substr(0, step);
+            term->digest(true);
+            crop.remove_prefix(step);
+        }
+    };
+    auto run = [&](char const* name, text const& data)
+    {
+        auto ns = measure(5, [&]{ feed(data); });
+        check(term->inbox.block.empty() && !term->sixels.active, "the whole sixel stream is decoded");
+        std::printf("  %-14s %6.2f MiB  %8.1f MB/s  %8.2f ms/image\n", name, (double)data.size() / (1 << 20), (double)data.size() / ns * 1e3, ns / 1e6);
+    };
+    std::printf("term::digest sixel decoding, 200x50 terminal, 64 KiB parts\n");
+    run("800x480 c256", make_image({ 800, 480 }, 256, 256));
+    run("palette first", make_image({ 800, 480 }, 16, (si32)(2 * ui::term::inbox_chunk / 16)));
+    term.reset();
+    return result();
+}
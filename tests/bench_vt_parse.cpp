@@ -0,0 +1,68 @@
+// Copyright (c) Dmitry Sapozhnikov
+// Licensed under the MIT license.
+
+// VT parser throughput through term::ondata_direct (ansi::parse -> vt_parser -> utf::decode -> bufferbase)
+// on a 200x50 terminal: plain printable ASCII (the vectorized run scan), mixed UTF-8 and SGR-heavy output.
+
+#include "netxs/apps.hpp"
+#include "testing.hpp"
+
+using namespace netxs;
+using namespace netxs::testing;
+
+auto make_input(auto line, size_t total)
+{
+    auto data = text{};
+    while (data.size() < total) data += line();
+    return data;
+}
+
+int main()
+{
+    auto& indexer = ui::tui_domain();
+    auto xmldoc = app::shared::load::settings("");
+    indexer.config.document.swap(xmldoc);
+    app::shared::get_tui_config(indexer.config, ui::skin::globals());
+    auto lock = indexer.unique_lock();
+    auto term = ui::term::ctor();
+    term->base::resize({ 200, 50 });
+
+    static constexpr auto total = 8_sz << 20; // 8 MiB per workload.
+    auto n = 0;
+    auto ascii = make_input([&]
+    {
+        return "[" + std::to_string(n++) + "/4096] Building CXX object src/netxs/CMakeFiles/vtm.dir/desktopio/terminal.cpp.o -O2 -std=c++20\r\n";
+    }, total);
+    auto mixed = make_input([&]
+    {
+        return "ls: " + std::to_string(n++) + " Файл «отчёт».txt 文件 ファイル Ελληνικά 😀👍🏽 é main.cpp\r\n";
+    }, total);
+    auto sgr = make_input([&]
+    {
+        n++;
+        return "\033[1;3" + std::to_string(n % 8) + "m" + "error" + "\033[0m: \033[38;2;" + std::to_string(n % 256) + ";128;64mvalue\033[m "
+             + "\033[4mline " + std::to_string(n) + "\033[24m\033[48;5;" + std::to_string(n % 256) + "m \033[49m\r\n";
+    }, total);
+    auto run = [&](char const* name, text const& data)
+    {
+        static constexpr auto chunk = 64_sz << 10; // Typical PTY read size.
+        auto ns = measure(3, [&]
+        {
+            auto crop = view{ data };
+            while (crop.size())
+            {
+                auto step = std::min(chunk, crop.size());
+                term->ondata_direct(crop.substr(0, step));
+                crop.remove_prefix(step);
+            }
+            term->ondata_direct(); // Flush.
+        });
+        std::printf("  %-10s %8.1f MB/s\n", name, (double)data.size() / ns * 1e3);
+    };
+    std::printf("term::ondata_direct, 200x50 terminal, %zu MiB per workload\n", total >> 20);
+    run("ascii", ascii);
+    run("utf-8", mixed);
+    run("sgr", sgr);
+    term.reset();
+    return 0;
+}
@@ -0,0 +1,74 @@
+// Copyright (c) Dmitry Sapozhnikov
+// Licensed under the MIT license.
+
+// The batched argb kernels (argb::blend, argb::alpha_sum, argb::alpha_mix) must produce exactly
+// the same colors as the scalar argb::mix, argb::alpha_sum and argb::alpha_mix for every alpha pair,
+// on every span length (SIMD steps plus the scalar tail), with the AVX2 path taken when the CPU supports it.
+
+#include "netxs/desktopio/canvas.hpp"
+#include "testing.hpp"
+
+using namespace netxs;
+using namespace netxs::testing;
+
+int main()
+{
+    #if defined(VTM_SIMD_DISPATCH)
+    std::printf("AVX2 path: %s\n", netxs::cpu_avx2() ? "on" : "off (not supported by the CPU)");
+    #else
+    std::printf("AVX2 path: off (not compiled)\n");
+    #endif
+    static constexpr auto channels = { 0x00, 0x01, 0x7F, 0x80, 0xFE, 0xFF };
+    auto span = std::vector<argb>{};
+    auto want = std::vector<argb>{};
+    auto mismatch = 0;
+    for (auto a2 = 0; a2 < 256; a2++) // Exhaustive over both alphas, the color channels take the boundary values and random ones.
+    {
+        span.clear();
+        for (auto a1 = 0; a1 < 256; a1++)
+        {
+            for (auto c : channels) span.push_back(argb{ c, 0xFF - c, random(0, 255), a1 });
+        }
+        auto c = argb{ random(0, 255), random(0, 255), random(0, 255), a2 };
+        for (auto c2 : channels)
+        {
+            c.chan.r = (byte)c2;
+            want = span;
+            for (auto& dst : want) dst.mix(c);
+            auto test = span;
+            argb::blend(test.data(), test.data() + test.size(), c);
+            if (test != want) mismatch++;
+        }
+    }
+    check(mismatch == 0, "argb::blend(span) == argb::mix for all alpha pairs");
+    for (auto count = 0; count <= 19; count++) // Span lengths around the SIMD steps.
+    {
+        auto test = std::vector<argb>(count);
+        for (auto& dst : test) dst = argb{ random<ui32>(0, ui32max) };
+        want = test;
+        auto c = argb{ random<ui32>(0, ui32max) };
+        for (auto& dst : want) dst.mix(c);
+        argb::blend(test.data(), test.data() + test.size(), c);
+        check(test == want, "argb::blend tail handling");
+    }
+    for (auto k : { -300, -255, -1, 0, 1, 77, 128, 254, 255, 256, 1000 })
+    {
+        for (auto count = 0; count <= 37; count++)
+        {
+            auto test = std::vector<argb>(count);
+            for (auto& dst : test) dst = argb{ random<ui32>(0, ui32max) };
+            want = test;
+            for (auto& dst : want) dst.alpha_sum(k);
+            argb::alpha_sum(test.data(), test.data() + test.size(), k);
+            check(test == want, "argb::alpha_sum(span) == argb::alpha_sum");
+
+            auto bytes = std::vector<byte>(count);
+            for (auto& b : bytes) b = (byte)random(0, 255);
+            auto bytes_want = bytes;
+            for (auto& b : bytes_want) argb::alpha_mix(k, b);
+            argb::alpha_mix(bytes.data(), bytes.data() + bytes.size(), k);
+            check(bytes == bytes_want, "argb::alpha_mix(span) == argb::alpha_mix");
+        }
+    }
+    return result();
+}
@@ -0,0 +1,85 @@
+// Copyright (c) Dmitry Sapozhnikov
+// Licensed under the MIT license.
+
+// binary::bitmap_dtvt_t must reproduce the canvas on the receiving side with and without the image runs (subtype::seq),
+// and must emit the runs only when they were negotiated (feature::runs), falling back to the plain cell records otherwise.
+
+#include "netxs/desktopio/directvt.hpp"
+#include "testing.hpp"
+
+using namespace netxs;
+using namespace netxs::testing;
+
+struct sender
+{
+    text frame;
+    void output(view block) { frame = block; }
+};
+
+auto encode(directvt::binary::bitmap_dtvt_t& bitmap, core const& canvas)
+{
+    auto damage = regs{ rect{ dot_00, canvas.size() } };
+    auto abort = flag{ faux };
+    auto delta = sz_t{};
+    auto link = sender{};
+    bitmap.set(1, dot_00, canvas, damage, abort, delta);
+    bitmap.sendby(link);
+    return link.frame;
+}
+auto decode(directvt::binary::bitmap_dtvt_t& bitmap, text const& frame)
+{
+    auto nat = std::array<ui16, 65536>{};
+    auto unk = std::vector<ui16>{};
+    auto data = view{ frame };
+    data.remove_prefix(sizeof(sz_t) + sizeof(directvt::binary::type)); // Frame size and kind.
+    bitmap.get(data, nat, unk);
+    return data.empty();
+}
+auto same(core const& a, core const& b)
+{
+    if (a.size() != b.size()) return faux;
+    auto iter = b.begin();
+    for (auto& c : a) if (!(c == *iter++)) return faux;
+    return true;
+}
+
+int main()
+{
+    static constexpr auto size = twod{ 80, 24 };
+    auto frame = core{};
+    frame.size(size, cell{});
+    for (auto y = 0; y < size.y; y++) // Text rows interleaved with image rows (the image fragment column advances along x).
+    {
+        for (auto x = 0; x < size.x; x++)
+        {
+            auto& c = *(frame.begin() + y * size.x + x);
+            if (y % 3 == 0) c.bgc(argb{ (ui32)(0xFF000000 | random<ui32>(0, 0xFFFFFF)) }).txt((char)random('!', '~'));
+            else            c.bgc(argb{ 0xFF202020 }).set_image_index(y).set_image_cr(x + 1, y);
+        }
+    }
+    auto next = frame;
+    for (auto n = 0; n < 50; n++) // Scattered changes.
+    {
+        auto& c = *(next.begin() + random(0, size.x * size.y - 1));
+        c.fgc(argb{ c.fgc().token ^ 0x00FFFFFF });
+    }
+
+    auto plain_size = 0_sz;
+    auto runs_size = 0_sz;
+    for (auto runs : { faux, true })
+    {
+        auto producer = directvt::binary::bitmap_dtvt_t{};
+        auto consumer = directvt::binary::bitmap_dtvt_t{};
+        producer.runs = runs;
+        auto full = encode(producer, frame);
+        check(decode(consumer, full), "full frame is consumed entirely");
+        check(same(consumer.image, frame), "full frame round trip");
+        auto diff = encode(producer, next);
+        check(decode(consumer, diff), "diff frame is consumed entirely");
+        check(same(consumer.image, next), "diff frame round trip");
+        (runs ? runs_size : plain_size) = full.size();
+    }
+    check(runs_size < plain_size, "image runs are emitted only when negotiated");
+    std::printf("full frame: %zu bytes plain, %zu bytes with image runs\n", plain_size, runs_size);
+    return result();
+}
@@ -0,0 +1,133 @@
+// Copyright (c) Dmitry Sapozhnikov
+// Licensed under the MIT license.
+
+// face::blur (misc::boxblur_bgc with the row-by-row vertical pass and the batched irgb kernels) and the column-by-column
+// netxs::boxblur must both produce the direct windowed sums of the box blur definition: every output is the sum of the
+// 2r+1 neighbors, where the neighbors beyond the edge take the edge value (InnerGlow) or the average of the r+1 edge
+// pixels, and a line not longer than r+1 takes its scaled average. Radii 1-8, the clip lengths around the window
+// width and the SIMD steps, and a clip inside a larger canvas are covered.
+
+#include "netxs/desktopio/richtext.hpp"
+#include "testing.hpp"
+
+using namespace netxs;
+using namespace netxs::testing;
+
+using quad = vrgb::value_type;
+
+template<bool InnerGlow>
+auto blur_line(std::vector<quad> const& x, si32 r) // One pass over a line (without the final division).
+{
+    auto n = (si32)x.size();
+    auto r1 = r + 1;
+    auto width = r + r + 1;
+    auto y = std::vector<quad>(n);
+    auto sum = quad{};
+    if (n <= r1)
+    {
+        for (auto& v : x) sum += v;
+        std::fill(y.begin(), y.end(), sum * width / n);
+        return y;
+    }
+    auto l_val = x.front();
+    auto r_val = x.back();
+    if constexpr (!InnerGlow)
+    {
+        l_val = quad{};
+        r_val = quad{};
+        for (auto i = 0; i < r1; i++) l_val += x[i];
+        for (auto i = n - r1; i < n; i++) r_val += x[i];
+        l_val = l_val / r1;
+        r_val = r_val / r1;
+    }
+    for (auto i = 0; i < n; i++)
+    {
+        sum = quad{};
+        for (auto k = i - r; k <= i + r; k++) sum += k < 0 ? l_val : k >= n ? r_val : x[k];
+        y[i] = sum;
+    }
+    return y;
+}
+template<bool InnerGlow>
+void reference(ui::face& canvas, si32 r, auto shade)
+{
+    auto clip = canvas.clip();
+    auto w = clip.size.x;
+    auto h = clip.size.y;
+    auto at = [&](si32 x, si32 y)->auto& { return *canvas.begin(clip.coor - canvas.area().coor + twod{ x, y }); };
+    auto count = (4 * r + 1) * (2 * r + 1);
+    for (auto _(2); _--;)
+    {
+        auto temp = std::vector<std::vector<quad>>(h);
+        for (auto y = 0; y < h; y++)
+        {
+            auto x = std::vector<quad>(w);
+            for (auto i = 0; i < w; i++) x[i] = at(i, y).bgc();
+            temp[y] = blur_line<InnerGlow>(x, 2 * r);
+        }
+        for (auto i = 0; i < w; i++)
+        {
+            auto x = std::vector<quad>(h);
+            for (auto y = 0; y < h; y++) x[y] = temp[y][i];
+            auto column = blur_line<InnerGlow>(x, r);
+            for (auto y = 0; y < h; y++)
+            {
+                at(i, y).bgc() = column[y] / count;
+                shade(at(i, y));
+            }
+        }
+    }
+}
+template<bool InnerGlow>
+void column_by_column(ui::face& canvas, si32 r, auto shade) // netxs::boxblur as used by face::blur before.
+{
+    auto area = canvas.area();
+    auto clip = canvas.clip();
+    auto cache = vrgb((size_t)clip.size.x * clip.size.y);
+    auto s_point = [](auto c)->auto& { return c->bgc(); };
+    auto d_point = [](auto c)->auto& { return *c;       };
+    for (auto _(2); _--;)
+    netxs::boxblur<quad, InnerGlow>(canvas.begin(clip.coor - area.coor), cache.begin(), clip.size.x, clip.size.y, r, area.size.x, clip.size.x, 2, s_point, d_point, shade);
+}
+auto same(ui::face const& a, ui::face const& b)
+{
+    auto iter = b.begin();
+    for (auto& c : a) if (c.bgc() != iter++->bgc() || c.fgc() != iter[-1].fgc()) return faux;
+    return true;
+}
+template<bool InnerGlow>
+void compare(ui::face const& canvas, si32 r, auto shade)
+{
+    auto expected = canvas;
+    auto actual = canvas;
+    auto columns = canvas;
+    reference<InnerGlow>(expected, r, shade);
+    actual.template blur<InnerGlow>(r, vrgb{}, shade);
+    column_by_column<InnerGlow>(columns, r, shade);
+    check(same(actual, expected), InnerGlow ? "face::blur produces the windowed sums (InnerGlow, shader)" : "face::blur produces the windowed sums");
+    check(same(columns, expected), InnerGlow ? "netxs::boxblur produces the windowed sums (InnerGlow, shader)" : "netxs::boxblur produces the windowed sums");
+}
+
+int main()
+{
+    auto shade = [](cell& c){ c.fgc(c.bgc()); };
+    auto cases = 0;
+    for (auto [w, h] : { std::pair{ 1, 1 }, { 3, 2 }, { 7, 5 }, { 9, 10 }, { 17, 18 }, { 64, 3 }, { 80, 24 }, { 131, 41 } })
+    {
+        for (auto inset : { 0, 3 })
+        {
+            auto canvas = ui::face{};
+            canvas.size({ w + 2 * inset, h + 2 * inset });
+            for (auto& c : canvas) c.bgc(argb{ (ui32)random<ui32>(0, 0xFFFFFFFF) });
+            canvas.clip({{ inset, inset }, { w, h }});
+            for (auto r = 1; r <= 8; r++)
+            {
+                compare<faux>(canvas, r, noop{});
+                compare<true>(canvas, r, shade);
+                cases++;
+            }
+        }
+    }
+    std::printf("%d cases\n", cases);
+    return result();
+}
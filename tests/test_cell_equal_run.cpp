@@ -0,0 +1,77 @@
+// Copyright (c) Dmitry Sapozhnikov
+// Licensed under the MIT license.
+
+// cell::equal_run() must agree with the scalar cell::operator == for every cell field and every run length,
+// including the tails shorter than a SIMD step and the link id bytes that are excluded from comparison.
+
+#include "netxs/desktopio/canvas.hpp"
+#include "testing.hpp"
+
+using namespace netxs;
+using namespace netxs::testing;
+
+auto scalar_run(cell const* a, cell const* b, size_t count)
+{
+    auto n = 0_sz;
+    while (n < count && a[n] == b[n]) n++;
+    return n;
+}
+auto random_cell()
+{
+    auto c = cell{};
+    c.bgc(argb{ random<ui32>(0, ui32max) })
+     .fgc(argb{ random<ui32>(0, ui32max) })
+     .bld(random(0, 1))
+     .itc(random(0, 1))
+     .und(random(0, 5))
+     .link(random<id_t>(0, 1000));
+    c.txt((char)random('!', '~'));
+    return c;
+}
+
+int main()
+{
+    static constexpr auto max_count = 19_sz; // Covers several AVX2 (4 cells) and SSE2 (2 cells) steps plus the scalar tail.
+    auto a = std::vector<cell>(max_count);
+    auto b = std::vector<cell>(max_count);
+    for (auto& c : a) c = random_cell();
+
+    for (auto count = 0_sz; count <= max_count; count++) // Equal sequences.
+    {
+        b = a;
+        check(cell::equal_run(a.data(), b.data(), count) == count, "equal sequences");
+        for (auto& c : b) c.link(c.link() + 1); // Link ids are not compared.
+        check(cell::equal_run(a.data(), b.data(), count) == count, "link ids are ignored");
+    }
+    for (auto count = 1_sz; count <= max_count; count++) // Single byte differences at every position of every cell.
+    {
+        for (auto at = 0_sz; at < count; at++)
+        {
+            for (auto byte_offset = 0_sz; byte_offset < sizeof(cell); byte_offset++)
+            {
+                b = a;
+                auto bytes = reinterpret_cast<byte*>(b.data() + at);
+                bytes[byte_offset] ^= 0x5A;
+                auto simd = cell::equal_run(a.data(), b.data(), count);
+                auto plain = scalar_run(a.data(), b.data(), count);
+                if (!check(simd == plain, "equal_run matches operator =="))
+                {
+                    std::printf("  count=%zu cell=%zu byte=%zu simd=%zu scalar=%zu\n", count, at, byte_offset, simd, plain);
+                }
+            }
+        }
+    }
+    for (auto i = 0; i < 10000; i++) // Random runs with random differences.
+    {
+        auto count = random(0_sz, max_count);
+        b = a;
+        auto diffs = random(0, 3);
+        while (diffs--)
+        {
+            auto at = random(0_sz, max_count - 1);
+            b[at] = random(0, 1) ? random_cell() : cell{ b[at] }.link(random<id_t>(0, 1000));
+        }
+        check(cell::equal_run(a.data(), b.data(), count) == scalar_run(a.data(), b.data(), count), "random runs");
+    }
+    return result();
+}
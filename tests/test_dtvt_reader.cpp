@@ -0,0 +1,119 @@
+// Copyright (c) Dmitry Sapozhnikov
+// Licensed under the MIT license.
+
+// stream::reading_loop must pass every DirectVT frame exactly once, whole and in order, however the stream is split
+// between reads: inside the size header, at the frame boundaries, one byte at a time, and with the frames larger than
+// the receive buffer (carried over and received straight into the carry buffer). The receive buffer is overwritten
+// before every read, so a frame passed late from a stale buffer is detected. A corrupted frame size and a proc
+// returning faux stop the reading.
+
+#include "netxs/desktopio/directvt.hpp"
+#include "testing.hpp"
+
+using namespace netxs;
+using namespace netxs::testing;
+
+using stream = directvt::binary::stream;
+
+struct fake_link // Link mock with the pipe receive interface.
+{
+    static constexpr auto chunk = 4096_sz; // Receive buffer size.
+
+    view                data; // fake_link: The stream to deliver.
+    std::vector<size_t> cuts; // fake_link: Sizes of the consecutive reads (cycled).
+    text                buff = text(chunk, '\0'); // fake_link: Receive buffer.
+    size_t              seek{}; // fake_link: Delivered bytes.
+    size_t              turn{}; // fake_link: Reads done.
+    size_t              direct{}; // fake_link: Reads into the caller's buffer.
+
+    explicit operator bool () const { return true; } // The end of the stream is reported by an empty read.
+    qiew recv(char* dest, size_t size)
+    {
+        auto count = std::min({ size, cuts[turn++ % cuts.size()], data.size() - seek });
+        if (dest != buff.data()) direct++;
+        ::memcpy(dest, data.data() + seek, count);
+        seek += count;
+        return qiew{ dest, count };
+    }
+    qiew recv()
+    {
+        std::fill(buff.begin(), buff.end(), '\xCC'); // Stale data must not be passed again.
+        return recv(buff.data(), buff.size());
+    }
+};
+
+auto make_stream(si32 count, size_t max_size)
+{
+    auto data = text{};
+    auto sizes = std::vector<size_t>{};
+    for (auto i = 0; i < count; i++)
+    {
+        auto size = (sz_t)random<size_t>(sizeof(sz_t), max_size);
+        auto head = netxs::letoh(size);
+        data.append((char const*)&head, sizeof(head));
+        for (auto n = sizeof(sz_t); n < size; n++) data.push_back((char)random(0, 255));
+        sizes.push_back(size);
+    }
+    return std::pair{ data, sizes };
+}
+auto run(view data, std::vector<size_t> cuts, auto&& proc)
+{
+    auto peer = fake_link{ .data = data, .cuts = cuts };
+    stream::reading_loop(peer, proc);
+    return peer;
+}
+auto frames(view batch, auto& sizes) // Split the batch into frames, return faux if the batch does not end at a frame end.
+{
+    while (batch.size() >= sizeof(sz_t))
+    {
+        auto size = (size_t)netxs::aligned<sz_t>(batch.data());
+        if (size < sizeof(sz_t) || size > batch.size()) return faux;
+        sizes.push_back(size);
+        batch.remove_prefix(size);
+    }
+    return batch.empty();
+}
+
+int main()
+{
+    auto [data, sizes] = make_stream(2000, 3 * fake_link::chunk);
+    auto splits = std::vector<std::vector<size_t>>{ { 1 }, { 2, 3 }, { 5, 7, 11 }, { fake_link::chunk }, { sizeof(sz_t) }, { 1, fake_link::chunk, 3 } };
+    auto random_cuts = std::vector<size_t>{};
+    for (auto i = 0; i < 997; i++) random_cuts.push_back(random<size_t>(1, fake_link::chunk));
+    splits.push_back(random_cuts);
+    auto boundaries = std::vector<size_t>{}; // Reads that end exactly at the frame ends.
+    for (auto size : sizes) boundaries.push_back(size);
+    splits.push_back(boundaries);
+    for (auto& cuts : splits)
+    {
+        auto got = text{};
+        auto got_sizes = std::vector<size_t>{};
+        auto whole = true;
+        auto peer = run(data, cuts, [&](qiew batch)
+        {
+            whole = whole && frames(batch, got_sizes);
+            got += batch;
+        });
+        check(whole, "only whole frames are passed");
+        check(peer.direct > 0, "the rest of a split frame is received into the carry buffer");
+        check(got_sizes == sizes, "every frame is passed once and in order");
+        check(got == data, "the frame bytes are intact");
+    }
+
+    auto corrupted = data.substr(0, sizes[0] + sizes[1]);
+    auto bad = netxs::letoh((sz_t)2);
+    corrupted.append((char const*)&bad, sizeof(bad));
+    corrupted += data.substr(sizes[0] + sizes[1]);
+    for (auto cuts : { std::vector<size_t>{ 1 }, std::vector<size_t>{ fake_link::chunk } })
+    {
+        auto got_sizes = std::vector<size_t>{};
+        auto seek = run(corrupted, cuts, [&](qiew batch){ frames(batch, got_sizes); }).seek;
+        check(got_sizes == std::vector<size_t>{ sizes[0], sizes[1] }, "the frames before a corrupted size are passed");
+        check(seek < corrupted.size(), "the reading stops at a corrupted size");
+    }
+
+    auto calls = 0;
+    auto seek = run(data, { fake_link::chunk }, [&](qiew){ return ++calls < 3; }).seek;
+    check(calls == 3 && seek < data.size(), "the reading stops when proc returns faux");
+    return result();
+}
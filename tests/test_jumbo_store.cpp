@@ -0,0 +1,63 @@
+// Copyright (c) Dmitry Sapozhnikov
+// Licensed under the MIT license.
+
+// The sharded jumbo cluster store (cell::glyf::jumbos()) must keep every distinct cluster once when the same clusters are
+// stored and read concurrently, report the entry count and memory, keep the references returned by get() valid while
+// other entries are added, and report the tokens that were looked up but are not stored.
+
+#include "netxs/desktopio/canvas.hpp"
+#include "testing.hpp"
+
+using namespace netxs;
+using namespace netxs::testing;
+
+auto cluster(si32 n) // Long enough to be stored outside the token.
+{
+    return "jumbo-cluster-" + std::to_string(n);
+}
+
+int main()
+{
+    static constexpr auto count = 20000;
+    static constexpr auto threads = 4;
+    auto jumbos = [] { return cell::glyf::jumbos(); };
+    auto [count_0, bytes_0] = jumbos().usage();
+
+    auto readable = std::array<std::atomic<bool>, threads>{};
+    auto agents = std::vector<std::thread>{};
+    for (auto t = 0; t < threads; t++)
+    {
+        agents.emplace_back([&, t]
+        {
+            auto okay = true;
+            for (auto i = 0; i < count; i++)
+            {
+                auto n = (i * 7919 + t * 104729) % count; // Every thread stores all clusters in its own order.
+                auto c = cell{}.txt(cluster(n), 1, 1, 1, 1);
+                okay = okay && c.txt() == cluster(n);
+            }
+            readable[t] = okay;
+        });
+    }
+    for (auto& a : agents) a.join();
+    auto all_readable = true;
+    for (auto& r : readable) all_readable = all_readable && r;
+    check(all_readable, "the clusters are readable while stored concurrently");
+    auto [count_1, bytes_1] = jumbos().usage();
+    check(count_1 == count_0 + count, "every distinct cluster is stored once");
+    check(bytes_1 - bytes_0 >= count * (si64)cluster(0).size(), "the memory of the stored clusters is reported");
+
+    for (auto n = 0; n < count; n++) cell{}.txt(cluster(n), 1, 1, 1, 1);
+    check(jumbos().usage() == std::pair{ count_1, bytes_1 }, "storing the same clusters again does not grow the store");
+
+    auto token = cell{}.txt(cluster(0), 1, 1, 1, 1).egc().jgc_token();
+    auto& value = jumbos().get(token);
+    for (auto n = count; n < 2 * count; n++) cell{}.txt(cluster(n), 1, 1, 1, 1); // Rehash the shards.
+    check(value == cluster(0), "a reference returned by get() stays valid while other clusters are added");
+
+    jumbos().unknown(); // Drop the tokens looked up earlier.
+    auto missing = ui64{ 0xDEAD'BEEF'0000'0001 };
+    check(!jumbos().exists(missing), "an unknown token does not exist");
+    check(jumbos().unknown() == std::vector<ui64>{ missing }, "an unknown token is reported once");
+    return result();
+}
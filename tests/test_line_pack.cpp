@@ -0,0 +1,153 @@
+// Copyright (c) Dmitry Sapozhnikov
+// Licensed under the MIT license.
+
+// The packed cold lines (line::freeze()) must unpack to the same cells (styles, colors, wide cluster fragments, attached
+// image bits, link ids, ascii runs, fills longer than a record, jumbo cluster tokens) after line::thaw() and after the
+// packed records are spilled to os::spool and read back, keep the line wrapping, alignment and direction, and leave the
+// image lines unpacked. In the terminal scrollback (scroll_buf::buff) every cold line must round-trip through freeze(),
+// spill and the access unpacking, and repack() must keep the lines around the viewport unpacked.
+
+#include "netxs/apps.hpp"
+#include "testing.hpp"
+
+using namespace netxs;
+using namespace netxs::testing;
+using netxs::ui::line;
+using deco = netxs::ansi::deco;
+
+auto same(std::vector<cell> const& a, std::vector<cell> const& b) // cell::operator== skips the link id.
+{
+    return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](auto& x, auto& y){ return x == y && x.id == y.id; });
+}
+auto styled_line(id_t index)
+{
+    auto l = line{};
+    l.reinitialize(index, deco{}, cell{}.fgc(0xFF'C0C0C0).bgc(0xFF'000000).txt(' '), 0);
+    auto brush = cell{}.fgc(0xFF'00FF00).bgc(0xFF'101010);
+    for (auto c : view{ "plain ascii run " }) l.cells.push_back(cell{ brush }.txt(c));
+    for (auto c : view{ "bold " }) l.cells.push_back(cell{ brush }.bld(true).txt(c));
+    for (auto c : view{ "italic underlined " }) l.cells.push_back(cell{ brush }.itc(true).und(1).fgc(0xFF'FF0000).txt(c));
+    for (auto c : view{ "inverted blinking" }) l.cells.push_back(cell{ brush }.inv(true).blk(true).txt(c));
+    l.cells.insert(l.cells.end(), 300, cell{ brush }.bgc(0xFF'0000FF).txt('=')); // Longer than one fill record.
+    l.cells.insert(l.cells.end(), 10, cell{ brush }.txt(' '));
+    for (auto cluster : { "文", "字", "😀" }) // Wide clusters: both fragments.
+    {
+        l.cells.push_back(cell{ brush }.txt(cluster, 2, 1, 1, 1));
+        l.cells.push_back(cell{ brush }.txt(cluster, 2, 1, 2, 1));
+    }
+    for (auto i = 0; i < 4; i++) l.cells.push_back(cell{ brush }.link(100 + i / 2).txt('L')); // Hyperlink ids.
+    for (auto i = 0; i < 3; i++) l.cells.push_back(cell{ brush }.img({ 0x1234'5678'9ABC'0000 + (ui64)i, 7u + i }).txt(' ')); // Image bits.
+    auto jumbo = "jumbo-cluster-" + std::to_string(index) + "-👍🏽👍🏽👍🏽"; // Stored in the jumbo cluster store.
+    l.cells.push_back(cell{ brush }.txt(jumbo, 1, 1, 1, 1));
+    l.cells.push_back(cell{ brush }.txt(jumbo, 1, 1, 1, 1));
+    l.cells.push_back(cell{ brush }.txt("é", 1, 1, 1, 1));
+    for (auto i = 0; i < 64; i++) l.cells.push_back(cell{ brush }.fgc(argb{ (ui32)(0xFF'000000 | (i * 0x030507)) }).txt((char)('a' + i % 26))); // Color per cell.
+    return l;
+}
+
+void line_round_trip()
+{
+    auto spool = os::spool{};
+    for (auto [wraps, align, r_2_l] : { std::tuple{ wrap::on, bias::left, faux }, std::tuple{ wrap::off, bias::center, true }, std::tuple{ wrap::off, bias::right, faux } })
+    {
+        auto l = styled_line(7);
+        l.wrp(wraps).jet(align).rtl(r_2_l);
+        auto cells = l.cells;
+        auto kind = l.get_kind();
+        l.freeze();
+        check(l.frozen() && l.cells.empty(), "the line is packed");
+        check(l.size() == (si32)cells.size() && l.get_kind() == kind, "the packed line keeps its length and kind");
+        l.thaw();
+        check(!l.frozen() && same(l.cells, cells), "freeze/thaw restores the cells");
+        check(l.wrapped() == (wraps == wrap::on) && l.align == align && (l.r_2_l == rtol::rtl) == r_2_l, "freeze/thaw keeps the wrapping, alignment and direction");
+
+        l.freeze();
+        auto ref = spool.append(l.packed());
+        check(ref != 0, "the packed records are spilled");
+        l.spill(ref);
+        check(l.spilled() && l.frozen() && l.size() == (si32)cells.size(), "the spilled line keeps its length");
+        l.thaw(spool.read(ref));
+        spool.release(ref);
+        check(!l.frozen() && same(l.cells, cells) && l.get_kind() == kind, "spill/read through os::spool restores the cells");
+    }
+
+    auto i = styled_line(8);
+    i.set_image_sixel(true);
+    auto cells = i.cells;
+    i.freeze();
+    check(!i.frozen() && same(i.cells, cells), "an image line stays unpacked");
+    auto e = line{};
+    e.freeze();
+    check(!e.frozen() && e.empty(), "an empty line stays unpacked");
+}
+
+void scrollback_round_trip()
+{
+    auto& indexer = ui::tui_domain();
+    auto xmldoc = app::shared::load::settings("");
+    indexer.config.document.swap(xmldoc);
+    app::shared::get_tui_config(indexer.config, ui::skin::globals());
+    auto lock = indexer.unique_lock();
+    auto term = ui::term::ctor();
+    term->base::resize({ 80, 25 });
+    auto& batch = term->normal.batch;
+    static constexpr auto thaw_limit = ui::term::scroll_buf::buff::thaw_limit;
+    batch.spill = ptr::shared<os::spool>();
+
+    static constexpr auto count = 12000;
+    auto depth = batch.depth;
+    batch.depth = count * 2; // Keep the lines unpacked until the snapshot.
+    auto data = text{};
+    for (auto n = 0; n < count; n++)
+    {
+        data += "\033[3" + std::to_string(n % 8) + "m" + std::to_string(n) + "\033[1m bold \033[4m文字😀\033[m \033[48;5;"
+              + std::to_string(n % 256) + "m" + text(n % 40, '=') + "\033[m jumbo-" + std::to_string(n) + "👍🏽\r\n";
+    }
+    term->ondata_direct(data);
+    term->ondata_direct(); // Flush.
+    auto total = batch.length();
+    auto limit = total - depth;
+    auto snapshot = std::vector<std::vector<cell>>{};
+    for (auto i = 0; i < limit; i++) snapshot.push_back(batch.peek(i).cells);
+    check(std::none_of(snapshot.begin(), snapshot.end(), [](auto& cells){ return cells.empty(); }), "the output lines are unpacked before the snapshot");
+    batch.depth = depth;
+    auto spilled = true;
+    for (auto i = 0; i < limit; i++)
+    {
+        batch.freeze(batch.peek(i));
+        spilled = spilled && batch.peek(i).spilled();
+    }
+    check(limit > thaw_limit && spilled, "the cold lines are packed and spilled");
+
+    batch.chill = true; // repack() is called below instead of the task queue.
+    auto restored = true;
+    for (auto i = 0; i < limit; i++) restored = restored && same(batch.at(i).cells, snapshot[i]);
+    check(restored, "every cold line is restored on access");
+
+    auto shown = limit / 2;
+    batch.ancid = batch.peek(shown).index;
+    batch.repack();
+    auto shown_thawed = true;
+    for (auto i = shown; i < shown + depth / 2; i++) shown_thawed = shown_thawed && !batch.peek(i).frozen();
+    check(shown_thawed, "repack() keeps the lines around the viewport unpacked");
+    check((si32)batch.thawn.size() == thaw_limit, "repack() keeps the most recently unpacked lines only");
+    auto packed = true;
+    auto queued = std::unordered_set<id_t>(batch.thawn.begin(), batch.thawn.end());
+    for (auto i = 0; i < limit; i++)
+    {
+        auto& l = batch.peek(i);
+        if (!queued.contains(l.index)) packed = packed && l.spilled();
+    }
+    check(packed, "repack() packs and spills the rest of the cold lines");
+    restored = true;
+    for (auto i = 0; i < limit; i++) restored = restored && same(batch.at(i).cells, snapshot[i]);
+    check(restored, "the repacked lines are restored on access");
+    term.reset();
+}
+
+int main()
+{
+    line_round_trip();
+    scrollback_round_trip();
+    return result();
+}
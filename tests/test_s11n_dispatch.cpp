@@ -0,0 +1,134 @@
+// Copyright (c) Dmitry Sapozhnikov
+// Licensed under the MIT license.
+
+// s11n::exec (the frame handler table indexed by the frame type) must route every frame of a replayed stream to the
+// right handler in the stream order: the bitmaps to boss.direct() with the raw payload, the objects with a boss.handle()
+// overload to it with the decoded struct, and the rest to the object sync only. The wire kinds of the bitmaps stay as
+// before (bitmap_dtvt=38, vtrgb=39, vt256=40, vt16=41, vt_2D=42), every object kind has a handler, an unknown kind is
+// skipped, and a compressed block is dispatched the same way as the plain one.
+
+#include "netxs/desktopio/directvt.hpp"
+#include "testing.hpp"
+
+using namespace netxs;
+using namespace netxs::testing;
+
+namespace binary = directvt::binary;
+using s11n = binary::s11n;
+using type = binary::type;
+
+static_assert(binary::bitmap_dtvt::kind == 38 && binary::bitmap_vtrgb::kind == 39 && binary::bitmap_vt256::kind == 40
+           && binary::bitmap_vt16::kind == 41 && binary::bitmap_vt_2D::kind == 42, "the bitmap wire kinds are fixed");
+
+struct host // Boss mock.
+{
+    std::vector<std::pair<type, text>> calls; // host: Handled frames: kind and payload/summary.
+
+    void direct(s11n::xs::bitmap_dtvt  /*lock*/, view& data) { calls.emplace_back(binary::bitmap_dtvt ::kind, data); }
+    void direct(s11n::xs::bitmap_vtrgb /*lock*/, view& data) { calls.emplace_back(binary::bitmap_vtrgb::kind, data); }
+    void direct(s11n::xs::bitmap_vt256 /*lock*/, view& data) { calls.emplace_back(binary::bitmap_vt256::kind, data); }
+    void direct(s11n::xs::bitmap_vt16  /*lock*/, view& data) { calls.emplace_back(binary::bitmap_vt16 ::kind, data); }
+    void direct(s11n::xs::bitmap_vt_2D /*lock*/, view& data) { calls.emplace_back(binary::bitmap_vt_2D::kind, data); }
+    void handle(s11n::xs::syskeybd lock) { calls.emplace_back(binary::syskeybd::kind, std::to_string(lock.thing.virtcod) + lock.thing.cluster); }
+    void handle(s11n::xs::sysmouse lock) { calls.emplace_back(binary::sysmouse::kind, std::to_string(lock.thing.buttons) + ":" + std::to_string(lock.thing.coordxy.x)); }
+    void handle(s11n::xs::fps      lock) { calls.emplace_back(binary::fps::kind, std::to_string(lock.thing.frame_rate)); }
+};
+struct sender // Output mock.
+{
+    text block; // sender: Sent frames.
+    void output(view data) { block += data; }
+};
+
+auto raw(type kind, view payload) // A frame with an opaque payload (bitmap frames are decoded by the boss).
+{
+    auto size = netxs::letoh((sz_t)(sizeof(sz_t) + sizeof(type) + payload.size()));
+    auto data = text{};
+    data.append((char const*)&size, sizeof(size));
+    data.push_back((char)kind);
+    data += payload;
+    return data;
+}
+auto record(host& boss, s11n& rx, view block)
+{
+    boss.calls.clear();
+    auto data = block;
+    rx.sync(data);
+    return boss.calls;
+}
+
+int main()
+{
+    auto boss = host{};
+    auto rx = s11n{ boss };
+    auto tx = s11n{};
+    auto out = sender{};
+    auto expected = std::vector<std::pair<type, text>>{};
+    auto bitmap = [&](type kind, text payload)
+    {
+        out.block += raw(kind, payload);
+        expected.emplace_back(kind, payload);
+    };
+    auto keybd = [&](si32 virtcod, text cluster)
+    {
+        auto lock = tx.syskeybd.freeze();
+        lock.thing.virtcod = virtcod;
+        lock.thing.cluster = cluster;
+        lock.thing.set();
+        lock.thing.sendby(out);
+        expected.emplace_back(binary::syskeybd::kind, std::to_string(virtcod) + cluster);
+    };
+    auto mouse = [&](si32 buttons, fp32 x)
+    {
+        auto lock = tx.sysmouse.freeze();
+        lock.thing.buttons = buttons;
+        lock.thing.coordxy = { x, 1.f };
+        lock.thing.set();
+        lock.thing.sendby(out);
+        expected.emplace_back(binary::sysmouse::kind, std::to_string(buttons) + ":" + std::to_string(x));
+    };
+    for (auto i = 0; i < 4; i++)
+    {
+        keybd(65 + i, text(1, (char)('a' + i)));
+        bitmap(binary::bitmap_dtvt ::kind, "dtvt" + std::to_string(i));
+        mouse(i, 10.5f * i);
+        bitmap(binary::bitmap_vtrgb::kind, "\x1b[38;2;1;2;3m" + std::to_string(i));
+        bitmap(binary::bitmap_vt256::kind, "\x1b[38;5;100m" + std::to_string(i));
+        bitmap(binary::bitmap_vt16 ::kind, "\x1b[31m" + std::to_string(i));
+        bitmap(binary::bitmap_vt_2D::kind, "2D" + std::to_string(i));
+    }
+    tx.fps.send(out, 60);
+    expected.emplace_back(binary::fps::kind, "60");
+    tx.header.send(out, id_t{ 7 }, "title"); // No boss.handle(): sync only.
+    out.block += raw(200, "unknown"); // Skipped.
+    bitmap(binary::bitmap_vt16::kind, "after unknown");
+
+    check(record(boss, rx, out.block) == expected, "every frame reaches its handler in order, the unknown kind is skipped");
+    check(rx.header.freeze().thing.utf8 == "title", "an object without a handler is synced");
+
+    auto kinds = std::vector<type>{ binary::bitmap_dtvt::kind, binary::bitmap_vt_2D::kind, binary::bitmap_vtrgb::kind, binary::bitmap_vt256::kind,
+        binary::bitmap_vt16::kind, binary::mouse_event::kind, binary::fullscrn::kind, binary::maximize::kind, binary::header::kind,
+        binary::footer::kind, binary::header_request::kind, binary::footer_request::kind, binary::warping::kind, binary::minimize::kind,
+        binary::expose::kind, binary::command::kind, binary::frames::kind, binary::logs::kind, binary::syskeybd::kind, binary::sysmouse::kind,
+        binary::sysfocus::kind, binary::sysstart::kind, binary::sysclose::kind, binary::syswinsz::kind, binary::sysboard::kind,
+        binary::clipdata::kind, binary::clipdata_request::kind, binary::mousebar::kind, binary::fps::kind, binary::init::kind, binary::cwd::kind,
+        binary::restored::kind, binary::req_input_fields::kind, binary::ack_input_fields::kind, binary::gui_command::kind,
+        binary::tooltip_element::kind, binary::tooltips::kind, binary::jgc_element::kind, binary::jgc_list::kind, binary::request_gc::kind,
+        binary::unknown_gc::kind, binary::img_element::kind, binary::img_list::kind, binary::request_img::kind, binary::unknown_img::kind,
+        binary::update_img_request::kind, binary::remove_img_request::kind, binary::features::kind, binary::rasterstat::kind, binary::packed_t::kind };
+    auto all_set = true;
+    for (auto kind : kinds) all_set = all_set && rx.exec[kind];
+    auto count = std::count_if(rx.exec.begin(), rx.exec.end(), [](auto proc){ return proc != nullptr; });
+    check(all_set, "every object kind has a handler");
+    auto sorted = kinds;
+    std::sort(sorted.begin(), sorted.end());
+    check(std::adjacent_find(sorted.begin(), sorted.end()) == sorted.end(), "the object kinds are distinct");
+    check(count == (si64)kinds.size(), "no other kind has a handler");
+
+    auto packer = binary::packer{};
+    auto packed = text{};
+    packer.enable(true);
+    packer.output(out.block, [&](view data){ packed += data; });
+    check(packed.size() < out.block.size() && packed[sizeof(sz_t)] == (char)binary::packed_t::kind, "the replayed block is compressed");
+    check(record(boss, rx, packed) == expected, "a compressed block is dispatched as the plain one");
+    return result();
+}
@@ -0,0 +1,63 @@
+// Copyright (c) Dmitry Sapozhnikov
+// Licensed under the MIT license.
+
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <source_location>
+
+namespace netxs::testing
+{
+    static auto failures = 0;
+
+    // testing: Report the failed condition.
+    inline bool check(bool condition, char const* what, std::source_location where = std::source_location::current())
+    {
+        if (!condition)
+        {
+            failures++;
+            std::printf("%s:%u: check failed: %s\n", where.file_name(), (unsigned)where.line(), what);
+        }
+        return condition;
+    }
+    // testing: Return the process exit code.
+    inline int result()
+    {
+        if (failures) std::printf("%d check(s) failed\n", failures);
+        else          std::printf("ok\n");
+        return failures ? 1 : 0;
+    }
+    // testing: Deterministic random generator.
+    inline auto& rng()
+    {
+        static auto engine = std::mt19937_64{ 0x5EED };
+        return engine;
+    }
+    // testing: Random integer in [min, max].
+    template<class T>
+    T random(T min, T max)
+    {
+        return (T)std::uniform_int_distribution<long long>{ (long long)min, (long long)max }(rng());
+    }
+    // testing: Run fx() the specified number of times and return the average time per run in nanoseconds.
+    inline double measure(long long count, auto&& fx)
+    {
+        fx(); // Warm up.
+        auto start = std::chrono::steady_clock::now();
+        for (auto i = 0ll; i < count; i++) fx();
+        auto spent = std::chrono::steady_clock::now() - start;
+        return std::chrono::duration<double, std::nano>(spent).count() / (double)count;
+    }
+    // testing: Keep the value from being optimized out and make the memory it depends on opaque to the optimizer.
+    inline void sink(auto const& value)
+    {
+        #if defined(__GNUC__) || defined(__clang__)
+            asm volatile("" : : "r"(&value) : "memory");
+        #else
+            static void const* volatile keep = nullptr;
+            keep = &value;
+        #endif
+    }
+}